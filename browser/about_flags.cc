@@ -120,7 +120,8 @@ constexpr char kBraveExtensionNetworkBlockingDescription[] =
 constexpr char kCosmeticFilteringSyncLoadName[] =
     "Enable sync loading of cosmetic filter rules";
 constexpr char kCosmeticFilteringSyncLoadDescription[] =
-    "Enable sync loading of cosmetic filter rules";
+    "Block on a sync load of cosmetic filter rules when they have not arrived "
+    "by the time the document starts loading";
 
 constexpr char kBraveIpfsName[] = "Enable IPFS";
 constexpr char kBraveIpfsDescription[] = "Enable native support of IPFS.";
@@ -9,6 +9,7 @@
 #include <utility>
 
 #include "base/hash/hash.h"
+#include "base/strings/stringprintf.h"
 #include "brave/browser/brave_ads/ads_service_factory.h"
 #include "chrome/browser/profiles/profile.h"
 #include "components/dom_distiller/content/browser/distiller_javascript_utils.h"
@@ -28,6 +29,14 @@
 
 namespace brave_ads {
 
+namespace {
+
+// Text classification only needs a sample of the page, so cap the text in the
+// renderer rather than copying the full text of large pages across IPC
+constexpr int kMaxTextLength = 32768;
+
+}  // namespace
+
 AdsTabHelper::AdsTabHelper(content::WebContents* web_contents)
     : WebContentsObserver(web_contents),
       tab_id_(sessions::SessionTabHelper::IdForTab(web_contents)),
@@ -66,13 +75,27 @@ void AdsTabHelper::RunIsolatedJavaScript(
     content::RenderFrameHost* render_frame_host) {
   DCHECK(render_frame_host);
 
-  dom_distiller::RunIsolatedJavaScript(
-      render_frame_host, "new XMLSerializer().serializeToString(document)",
-      base::BindOnce(&AdsTabHelper::OnJavaScriptHtmlResult,
-                     weak_factory_.GetWeakPtr()));
+  // Results are dropped by the ads service when ads are disabled, so avoid
+  // serializing the page in the renderer at all
+  if (!ads_service_ || !ads_service_->IsEnabled()) {
+    return;
+  }
+
+  // The HTML is only used to extract conversion ids, but ad transfers are
+  // also checked when HTML is loaded so still notify with the redirect chain
+  if (ads_service_->ShouldAllowConversionTracking()) {
+    dom_distiller::RunIsolatedJavaScript(
+        render_frame_host, "new XMLSerializer().serializeToString(document)",
+        base::BindOnce(&AdsTabHelper::OnJavaScriptHtmlResult,
+                       weak_factory_.GetWeakPtr()));
+  } else {
+    ads_service_->OnHtmlLoaded(tab_id_, redirect_chain_, /* html */ "");
+  }
 
   dom_distiller::RunIsolatedJavaScript(
-      render_frame_host, "document?.body?.innerText",
+      render_frame_host,
+      base::StringPrintf("document?.body?.innerText?.substring(0, %d)",
+                         kMaxTextLength),
       base::BindOnce(&AdsTabHelper::OnJavaScriptTextResult,
                      weak_factory_.GetWeakPtr()));
 }
@@ -0,0 +1,115 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/browser/brave_ads/ads_tab_helper.h"
+
+#include <memory>
+
+#include "base/bind.h"
+#include "brave/browser/brave_ads/ads_service_factory.h"
+#include "brave/components/brave_ads/browser/ads_service_mock.h"
+#include "chrome/test/base/chrome_render_view_host_test_harness.h"
+#include "components/sessions/content/session_tab_helper.h"
+#include "content/public/test/navigation_simulator.h"
+#include "testing/gmock/include/gmock/gmock.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+// npm run test -- brave_unit_tests --filter=BraveAdsTabHelperTest*
+
+using ::testing::_;
+using ::testing::ElementsAre;
+using ::testing::NiceMock;
+using ::testing::Return;
+
+namespace brave_ads {
+
+namespace {
+
+std::unique_ptr<KeyedService> BuildAdsService(
+    content::BrowserContext* context) {
+  return std::make_unique<NiceMock<AdsServiceMock>>();
+}
+
+}  // namespace
+
+class BraveAdsTabHelperTest : public ChromeRenderViewHostTestHarness {
+ protected:
+  BraveAdsTabHelperTest() = default;
+
+  ~BraveAdsTabHelperTest() override = default;
+
+  void SetUp() override {
+    ChromeRenderViewHostTestHarness::SetUp();
+
+    ads_service_mock_ = static_cast<AdsServiceMock*>(
+        AdsServiceFactory::GetForProfile(profile()));
+    ASSERT_TRUE(ads_service_mock_);
+
+    ON_CALL(*ads_service_mock_, IsEnabled()).WillByDefault(Return(true));
+
+    sessions::SessionTabHelper::CreateForWebContents(web_contents());
+    AdsTabHelper::CreateForWebContents(web_contents());
+
+    NavigateAndCommit(GURL("https://brave.com/"));
+  }
+
+  TestingProfile::TestingFactories GetTestingFactories() const override {
+    return {{AdsServiceFactory::GetInstance(),
+             base::BindRepeating(&BuildAdsService)}};
+  }
+
+  void NavigateSameDocument(const GURL& url) {
+    content::NavigationSimulator::CreateRendererInitiated(url, main_rfh())
+        ->CommitSameDocument();
+  }
+
+  SessionID GetTabId() {
+    return sessions::SessionTabHelper::IdForTab(web_contents());
+  }
+
+  AdsServiceMock* ads_service_mock_ = nullptr;  // NOT OWNED
+};
+
+TEST_F(BraveAdsTabHelperTest,
+       NotifyHtmlLoadedWithoutHtmlIfConversionTrackingIsNotAllowed) {
+  // Arrange
+  ON_CALL(*ads_service_mock_, ShouldAllowConversionTracking())
+      .WillByDefault(Return(false));
+
+  // Assert
+  const GURL url("https://brave.com/#transfer");
+  EXPECT_CALL(*ads_service_mock_,
+              OnHtmlLoaded(GetTabId(), ElementsAre(url), ""));
+
+  // Act
+  NavigateSameDocument(url);
+}
+
+TEST_F(BraveAdsTabHelperTest,
+       DoNotNotifyHtmlLoadedWithoutHtmlIfConversionTrackingIsAllowed) {
+  // Arrange
+  ON_CALL(*ads_service_mock_, ShouldAllowConversionTracking())
+      .WillByDefault(Return(true));
+
+  // Assert
+  EXPECT_CALL(*ads_service_mock_, OnHtmlLoaded(_, _, "")).Times(0);
+
+  // Act
+  NavigateSameDocument(GURL("https://brave.com/#transfer"));
+}
+
+TEST_F(BraveAdsTabHelperTest, DoNotNotifyHtmlLoadedIfAdsAreDisabled) {
+  // Arrange
+  ON_CALL(*ads_service_mock_, IsEnabled()).WillByDefault(Return(false));
+
+  // Assert
+  EXPECT_CALL(*ads_service_mock_, OnHtmlLoaded(_, _, _)).Times(0);
+
+  // Act
+  NavigateSameDocument(GURL("https://brave.com/#transfer"));
+}
+
+}  // namespace brave_ads
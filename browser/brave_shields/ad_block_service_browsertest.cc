@@ -15,6 +15,7 @@
 #include "base/task/post_task.h"
 #include "base/test/thread_test_helper.h"
 #include "brave/browser/brave_browser_process.h"
+#include "brave/browser/brave_shields/brave_shields_web_contents_observer.h"
 #include "brave/browser/net/brave_ad_block_tp_network_delegate_helper.h"
 #include "brave/common/brave_paths.h"
 #include "brave/common/pref_names.h"
@@ -79,6 +80,14 @@ using brave_shields::features::kBraveAdblockDefault1pBlocking;
 void AdBlockServiceTest::SetUpOnMainThread() {
   ExtensionBrowserTest::SetUpOnMainThread();
   host_resolver()->AddRule("*", "127.0.0.1");
+  brave_shields::BraveShieldsWebContentsObserver::
+      SetShouldFlushBlockedCountsImmediatelyForTesting(true);
+}
+
+void AdBlockServiceTest::TearDownOnMainThread() {
+  brave_shields::BraveShieldsWebContentsObserver::
+      SetShouldFlushBlockedCountsImmediatelyForTesting(false);
+  ExtensionBrowserTest::TearDownOnMainThread();
 }
 
 void AdBlockServiceTest::SetUp() {
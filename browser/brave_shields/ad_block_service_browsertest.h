@@ -18,6 +18,7 @@ class AdBlockServiceTest : public extensions::ExtensionBrowserTest {
 
   // ExtensionBrowserTest overrides
   void SetUpOnMainThread() override;
+  void TearDownOnMainThread() override;
   void SetUp() override;
   void PreRunTestOnMainThread() override;
 
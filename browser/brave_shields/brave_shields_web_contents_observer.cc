@@ -9,9 +9,13 @@
 #include <string>
 #include <utility>
 
+#include "base/bind.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/time/time.h"
+#include "brave/browser/brave_browser_process.h"
 #include "brave/common/pref_names.h"
 #include "brave/components/brave_perf_predictor/browser/perf_predictor_tab_helper.h"
+#include "brave/components/brave_shields/browser/ad_block_service.h"
 #include "brave/components/brave_shields/browser/brave_shields_util.h"
 #include "brave/components/brave_shields/common/brave_shield_constants.h"
 #include "chrome/browser/content_settings/host_content_settings_map_factory.h"
@@ -50,6 +54,13 @@ namespace {
 
 BraveShieldsWebContentsObserver* g_receiver_impl_for_testing = nullptr;
 
+bool g_should_flush_blocked_counts_immediately_for_testing = false;
+
+// Tracker-heavy pages block hundreds of subresources per load, so blocked
+// counts are coalesced rather than written to prefs one at a time.
+constexpr base::TimeDelta kFlushBlockedCountsDelay =
+    base::TimeDelta::FromSeconds(5);
+
 // Content Settings are only sent to the main frame currently. Chrome may fix
 // this at some point, but for now we do this as a work-around. You can verify
 // if this is fixed by running the following test: npm run test --
@@ -79,6 +90,7 @@ void UpdateContentSettingsToRendererFrames(content::WebContents* web_contents) {
 }  // namespace
 
 BraveShieldsWebContentsObserver::~BraveShieldsWebContentsObserver() {
+  DCHECK(pending_blocked_counts_.empty());
   brave_shields_remotes_.clear();
 }
 
@@ -123,6 +135,51 @@ void BraveShieldsWebContentsObserver::AddBlockedSubresource(
   blocked_url_paths_.insert(subresource);
 }
 
+// static
+void BraveShieldsWebContentsObserver::
+    SetShouldFlushBlockedCountsImmediatelyForTesting(
+        bool should_flush_immediately) {
+  g_should_flush_blocked_counts_immediately_for_testing =
+      should_flush_immediately;
+}
+
+void BraveShieldsWebContentsObserver::IncrementBlockedCount(
+    const std::string& pref_name) {
+  pending_blocked_counts_[pref_name]++;
+
+  if (g_should_flush_blocked_counts_immediately_for_testing) {
+    FlushBlockedCounts();
+    return;
+  }
+
+  if (!flush_blocked_counts_timer_.IsRunning()) {
+    flush_blocked_counts_timer_.Start(
+        FROM_HERE, kFlushBlockedCountsDelay,
+        base::BindOnce(&BraveShieldsWebContentsObserver::FlushBlockedCounts,
+                       base::Unretained(this)));
+  }
+}
+
+void BraveShieldsWebContentsObserver::FlushBlockedCounts() {
+  flush_blocked_counts_timer_.Stop();
+
+  if (pending_blocked_counts_.empty()) {
+    return;
+  }
+
+  PrefService* prefs =
+      Profile::FromBrowserContext(web_contents()->GetBrowserContext())
+          ->GetOriginalProfile()
+          ->GetPrefs();
+  for (const auto& pending_blocked_count : pending_blocked_counts_) {
+    const std::string& pref_name = pending_blocked_count.first;
+    const uint64_t count = pending_blocked_count.second;
+    prefs->SetUint64(pref_name, prefs->GetUint64(pref_name) + count);
+  }
+
+  pending_blocked_counts_.clear();
+}
+
 // static
 void BraveShieldsWebContentsObserver::BindBraveShieldsHost(
     mojo::PendingAssociatedReceiver<brave_shields::mojom::BraveShieldsHost>
@@ -161,21 +218,15 @@ void BraveShieldsWebContentsObserver::DispatchBlockedEvent(
         BraveShieldsWebContentsObserver::FromWebContents(web_contents);
     if (observer && !observer->IsBlockedSubresource(subresource)) {
       observer->AddBlockedSubresource(subresource);
-      PrefService* prefs =
-          Profile::FromBrowserContext(web_contents->GetBrowserContext())
-              ->GetOriginalProfile()
-              ->GetPrefs();
 
       if (block_type == kAds) {
-        prefs->SetUint64(kAdsBlocked, prefs->GetUint64(kAdsBlocked) + 1);
+        observer->IncrementBlockedCount(kAdsBlocked);
       } else if (block_type == kHTTPUpgradableResources) {
-        prefs->SetUint64(kHttpsUpgrades, prefs->GetUint64(kHttpsUpgrades) + 1);
+        observer->IncrementBlockedCount(kHttpsUpgrades);
       } else if (block_type == kJavaScript) {
-        prefs->SetUint64(kJavascriptBlocked,
-                         prefs->GetUint64(kJavascriptBlocked) + 1);
+        observer->IncrementBlockedCount(kJavascriptBlocked);
       } else if (block_type == kFingerprintingV2) {
-        prefs->SetUint64(kFingerprintingBlocked,
-                         prefs->GetUint64(kFingerprintingBlocked) + 1);
+        observer->IncrementBlockedCount(kFingerprintingBlocked);
       }
     }
   }
@@ -237,6 +288,8 @@ void BraveShieldsWebContentsObserver::ReadyToCommitNavigation(
   content::ReloadType reload_type = navigation_handle->GetReloadType();
   if (navigation_handle->IsInMainFrame() &&
       !navigation_handle->IsSameDocument()) {
+    FlushBlockedCounts();
+
     if (reload_type == content::ReloadType::NONE) {
       // For new loads, we reset the counters for both blocked scripts and URLs.
       allowed_script_origins_.clear();
@@ -254,6 +307,39 @@ void BraveShieldsWebContentsObserver::ReadyToCommitNavigation(
     GetBraveShieldsRemote(rfh)->SetAllowScriptsFromOriginsOnce(
         allowed_script_origins_);
   }
+
+  MaybePrefetchCosmeticResources(navigation_handle);
+}
+
+void BraveShieldsWebContentsObserver::WebContentsDestroyed() {
+  FlushBlockedCounts();
+}
+
+void BraveShieldsWebContentsObserver::MaybePrefetchCosmeticResources(
+    content::NavigationHandle* navigation_handle) {
+  if (navigation_handle->IsSameDocument() ||
+      !navigation_handle->GetURL().SchemeIsHTTPOrHTTPS()) {
+    return;
+  }
+
+  // Cosmetic filtering settings are looked up for the top-level page, which
+  // is the navigation's own URL for main frames.
+  const GURL& top_level_url =
+      navigation_handle->IsInMainFrame()
+          ? navigation_handle->GetURL()
+          : navigation_handle->GetWebContents()->GetLastCommittedURL();
+  HostContentSettingsMap* map = HostContentSettingsMapFactory::GetForProfile(
+      navigation_handle->GetWebContents()->GetBrowserContext());
+  if (!GetBraveShieldsEnabled(map, top_level_url) ||
+      GetCosmeticFilteringControlType(map, top_level_url) ==
+          ControlType::ALLOW) {
+    return;
+  }
+
+  // Start computing the cosmetic resources while the commit is on its way to
+  // the renderer, which requests them as soon as it commits.
+  g_brave_browser_process->ad_block_service()->PrefetchUrlCosmeticResources(
+      navigation_handle->GetURL());
 }
 
 void BraveShieldsWebContentsObserver::AllowScriptsOnce(
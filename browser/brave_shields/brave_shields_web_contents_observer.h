@@ -7,13 +7,14 @@
 #define BRAVE_BROWSER_BRAVE_SHIELDS_BRAVE_SHIELDS_WEB_CONTENTS_OBSERVER_H_
 
 #include <map>
-#include <set>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 #include "base/containers/flat_map.h"
 #include "base/macros.h"
 #include "base/synchronization/lock.h"
+#include "base/timer/timer.h"
 #include "brave/components/brave_shields/common/brave_shields.mojom.h"
 #include "content/public/browser/render_frame_host_receiver_set.h"
 #include "content/public/browser/web_contents_observer.h"
@@ -54,6 +55,12 @@ class BraveShieldsWebContentsObserver
   bool IsBlockedSubresource(const std::string& subresource);
   void AddBlockedSubresource(const std::string& subresource);
 
+  // Blocked counts are accumulated per tab and written to the profile prefs
+  // after a delay or when the tab navigates away. Tests that read the prefs
+  // right after a block can ask for every block to be written immediately.
+  static void SetShouldFlushBlockedCountsImmediatelyForTesting(
+      bool should_flush_immediately);
+
  protected:
   // content::WebContentsObserver overrides.
   void RenderFrameCreated(content::RenderFrameHost* host) override;
@@ -62,6 +69,7 @@ class BraveShieldsWebContentsObserver
                               content::RenderFrameHost* new_host) override;
   void ReadyToCommitNavigation(
       content::NavigationHandle* navigation_handle) override;
+  void WebContentsDestroyed() override;
 
   // brave_shields::mojom::BraveShieldsHost.
   void OnJavaScriptBlocked(const std::u16string& details) override;
@@ -90,10 +98,23 @@ class BraveShieldsWebContentsObserver
   mojo::AssociatedRemote<brave_shields::mojom::BraveShields>&
   GetBraveShieldsRemote(content::RenderFrameHost* rfh);
 
+  // Warms the adblock service's cosmetic resources cache for the frame that
+  // is about to commit, unless cosmetic filtering is off for the page.
+  void MaybePrefetchCosmeticResources(
+      content::NavigationHandle* navigation_handle);
+
+  void IncrementBlockedCount(const std::string& pref_name);
+  void FlushBlockedCounts();
+
   std::vector<std::string> allowed_script_origins_;
   // We keep a set of the current page's blocked URLs in case the page
   // continually tries to load the same blocked URLs.
-  std::set<std::string> blocked_url_paths_;
+  std::unordered_set<std::string> blocked_url_paths_;
+
+  // Blocked counts keyed by pref name which have not yet been written to the
+  // profile prefs.
+  base::flat_map<std::string, uint64_t> pending_blocked_counts_;
+  base::OneShotTimer flush_blocked_counts_timer_;
 
   content::RenderFrameHostReceiverSet<brave_shields::mojom::BraveShieldsHost>
       receivers_;
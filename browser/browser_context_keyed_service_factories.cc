@@ -11,6 +11,8 @@
 #include "brave/browser/brave_shields/cookie_pref_service_factory.h"
 #include "brave/browser/debounce/debounce_service_factory.h"
 #include "brave/browser/ethereum_remote_client/buildflags/buildflags.h"
+#include "brave/browser/net/ad_block_cname_uncloaking_service_factory.h"
+#include "brave/browser/net/shields_settings_snapshot_service_factory.h"
 #include "brave/browser/ntp_background_images/view_counter_service_factory.h"
 #include "brave/browser/permissions/permission_lifetime_manager_factory.h"
 #include "brave/browser/search_engines/search_engine_provider_service_factory.h"
@@ -63,6 +65,8 @@ void EnsureBrowserContextKeyedServiceFactoriesBuilt() {
   brave_rewards::RewardsServiceFactory::GetInstance();
   brave_shields::AdBlockPrefServiceFactory::GetInstance();
   brave_shields::CookiePrefServiceFactory::GetInstance();
+  brave::AdBlockCnameUncloakingServiceFactory::GetInstance();
+  brave::ShieldsSettingsSnapshotServiceFactory::GetInstance();
   debounce::DebounceServiceFactory::GetInstance();
 #if BUILDFLAG(ENABLE_GREASELION)
   greaselion::GreaselionServiceFactory::GetInstance();
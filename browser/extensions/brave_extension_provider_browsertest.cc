@@ -6,6 +6,7 @@
 #include "base/path_service.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/test/thread_test_helper.h"
+#include "brave/browser/brave_shields/brave_shields_web_contents_observer.h"
 #include "brave/browser/extensions/brave_extension_functional_test.h"
 #include "brave/common/brave_paths.h"
 #include "brave/common/pref_names.h"
@@ -22,6 +23,14 @@ class BraveExtensionProviderTest : public extensions::ExtensionFunctionalTest {
  public:
   void SetUpOnMainThread() override {
     extensions::ExtensionFunctionalTest::SetUpOnMainThread();
+    brave_shields::BraveShieldsWebContentsObserver::
+        SetShouldFlushBlockedCountsImmediatelyForTesting(true);
+  }
+
+  void TearDownOnMainThread() override {
+    brave_shields::BraveShieldsWebContentsObserver::
+        SetShouldFlushBlockedCountsImmediatelyForTesting(false);
+    extensions::ExtensionFunctionalTest::TearDownOnMainThread();
   }
 };
 
@@ -0,0 +1,128 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/browser/net/ad_block_cname_uncloaking_service.h"
+
+#include <utility>
+
+#include "base/metrics/histogram_macros.h"
+#include "chrome/browser/net/proxy_service_factory.h"
+#include "chrome/browser/profiles/profile.h"
+#include "components/proxy_config/pref_proxy_config_tracker.h"
+#include "content/public/browser/browser_thread.h"
+#include "net/proxy_resolution/proxy_config.h"
+#include "net/proxy_resolution/proxy_config_with_annotation.h"
+
+namespace brave {
+
+namespace {
+
+constexpr size_t kCnameCacheSize = 256;
+
+// Canonical names are reused for this long. The network service's own host
+// cache still applies to every lookup that does reach it.
+constexpr base::TimeDelta kCnameCacheTTL = base::TimeDelta::FromMinutes(1);
+
+}  // namespace
+
+AdBlockCnameUncloakingService::AdBlockCnameUncloakingService(Profile* profile)
+    : cname_cache_(kCnameCacheSize) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  config_tracker_ = ProxyServiceFactory::CreatePrefProxyConfigTrackerOfProfile(
+      profile->GetPrefs(), nullptr);
+  proxy_config_service_ =
+      ProxyServiceFactory::CreateProxyConfigService(config_tracker_.get());
+  proxy_config_service_->AddObserver(this);
+
+  net::ProxyConfigWithAnnotation config;
+  OnProxyConfigChanged(config,
+                       proxy_config_service_->GetLatestProxyConfig(&config));
+}
+
+AdBlockCnameUncloakingService::~AdBlockCnameUncloakingService() {
+  DCHECK(!proxy_config_service_);
+}
+
+void AdBlockCnameUncloakingService::Shutdown() {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  proxy_config_service_->RemoveObserver(this);
+  proxy_config_service_.reset();
+  config_tracker_->DetachFromPrefService();
+
+  // Don't leave requests waiting on a resolution that will never be reported.
+  std::map<CnameKey, std::vector<CnameCallback>> pending_resolves;
+  pending_resolves.swap(pending_resolves_);
+  for (auto& pending : pending_resolves) {
+    for (auto& callback : pending.second)
+      std::move(callback).Run(absl::nullopt);
+  }
+}
+
+void AdBlockCnameUncloakingService::OnProxyConfigChanged(
+    const net::ProxyConfigWithAnnotation& config,
+    net::ProxyConfigService::ConfigAvailability availability) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  if (availability ==
+      net::ProxyConfigService::ConfigAvailability::CONFIG_PENDING) {
+    return;
+  }
+  // PROXY_LIST corresponds to SingleProxy mode.
+  proxy_settings_allow_uncloaking_ =
+      availability !=
+          net::ProxyConfigService::ConfigAvailability::CONFIG_VALID ||
+      config.value().proxy_rules().type !=
+          net::ProxyConfig::ProxyRules::Type::PROXY_LIST;
+}
+
+absl::optional<std::string> AdBlockCnameUncloakingService::GetCachedCname(
+    const net::NetworkIsolationKey& network_isolation_key,
+    const std::string& host) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  auto it = cname_cache_.Get(CnameKey(network_isolation_key, host));
+  if (it != cname_cache_.end() &&
+      it->second.expiration <= base::TimeTicks::Now()) {
+    cname_cache_.Erase(it);
+    it = cname_cache_.end();
+  }
+  UMA_HISTOGRAM_BOOLEAN("Brave.ShieldsCNAMEBlocking.CacheHit",
+                        it != cname_cache_.end());
+  if (it == cname_cache_.end())
+    return absl::nullopt;
+  return it->second.cname;
+}
+
+bool AdBlockCnameUncloakingService::AddPendingResolve(
+    const net::NetworkIsolationKey& network_isolation_key,
+    const std::string& host,
+    CnameCallback callback) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  std::vector<CnameCallback>& callbacks =
+      pending_resolves_[CnameKey(network_isolation_key, host)];
+  callbacks.push_back(std::move(callback));
+  return callbacks.size() == 1;
+}
+
+void AdBlockCnameUncloakingService::OnCnameResolved(
+    const net::NetworkIsolationKey& network_isolation_key,
+    const std::string& host,
+    absl::optional<std::string> cname) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  CnameKey key(network_isolation_key, host);
+  // Failures aren't cached, the next request retries the lookup.
+  if (cname.has_value()) {
+    cname_cache_.Put(key,
+                     {*cname, base::TimeTicks::Now() + kCnameCacheTTL});
+  }
+
+  auto it = pending_resolves_.find(key);
+  if (it == pending_resolves_.end())
+    return;
+  std::vector<CnameCallback> callbacks = std::move(it->second);
+  pending_resolves_.erase(it);
+  for (auto& callback : callbacks)
+    std::move(callback).Run(cname);
+}
+
+}  // namespace brave
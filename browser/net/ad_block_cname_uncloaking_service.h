@@ -0,0 +1,103 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_BROWSER_NET_AD_BLOCK_CNAME_UNCLOAKING_SERVICE_H_
+#define BRAVE_BROWSER_NET_AD_BLOCK_CNAME_UNCLOAKING_SERVICE_H_
+
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/callback.h"
+#include "base/containers/mru_cache.h"
+#include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
+#include "components/keyed_service/core/keyed_service.h"
+#include "net/base/network_isolation_key.h"
+#include "net/proxy_resolution/proxy_config_service.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
+
+class PrefProxyConfigTracker;
+class Profile;
+
+namespace brave {
+
+// Per-profile state used to decide on and perform CNAME uncloaking of
+// subresource requests on the UI thread.
+//
+// Keeps the profile's proxy mode up to date through a proxy config observer,
+// so requests don't need to build a proxy config service to read it, and
+// caches the canonical names of recently resolved hosts by network isolation
+// key, so repeated requests to the same cloaked host reuse the answer.
+class AdBlockCnameUncloakingService : public KeyedService,
+                                      public net::ProxyConfigService::Observer {
+ public:
+  using CnameCallback = base::OnceCallback<void(absl::optional<std::string>)>;
+
+  explicit AdBlockCnameUncloakingService(Profile* profile);
+  AdBlockCnameUncloakingService(const AdBlockCnameUncloakingService&) = delete;
+  AdBlockCnameUncloakingService& operator=(
+      const AdBlockCnameUncloakingService&) = delete;
+  ~AdBlockCnameUncloakingService() override;
+
+  // If only particular types of network traffic are being proxied, or if no
+  // proxy is configured, it should be safe to continue making unproxied DNS
+  // queries. However, in SingleProxy mode all types of network traffic should
+  // go through the proxy, so additional DNS queries should be avoided.
+  bool proxy_settings_allow_uncloaking() const {
+    return proxy_settings_allow_uncloaking_;
+  }
+
+  // Returns the canonical name of |host| if it was resolved recently for
+  // |network_isolation_key|.
+  absl::optional<std::string> GetCachedCname(
+      const net::NetworkIsolationKey& network_isolation_key,
+      const std::string& host);
+
+  // Queues |callback| for the result of resolving |host|. Returns true if no
+  // resolution was running yet, in which case the caller must start one and
+  // report back with OnCnameResolved().
+  bool AddPendingResolve(const net::NetworkIsolationKey& network_isolation_key,
+                         const std::string& host,
+                         CnameCallback callback);
+  void OnCnameResolved(const net::NetworkIsolationKey& network_isolation_key,
+                       const std::string& host,
+                       absl::optional<std::string> cname);
+
+  base::WeakPtr<AdBlockCnameUncloakingService> AsWeakPtr() {
+    return weak_factory_.GetWeakPtr();
+  }
+
+  // KeyedService:
+  void Shutdown() override;
+
+  // net::ProxyConfigService::Observer:
+  void OnProxyConfigChanged(
+      const net::ProxyConfigWithAnnotation& config,
+      net::ProxyConfigService::ConfigAvailability availability) override;
+
+ private:
+  using CnameKey = std::pair<net::NetworkIsolationKey, std::string>;
+
+  struct CachedCname {
+    std::string cname;
+    base::TimeTicks expiration;
+  };
+
+  std::unique_ptr<PrefProxyConfigTracker> config_tracker_;
+  std::unique_ptr<net::ProxyConfigService> proxy_config_service_;
+  bool proxy_settings_allow_uncloaking_ = true;
+
+  base::MRUCache<CnameKey, CachedCname> cname_cache_;
+  std::map<CnameKey, std::vector<CnameCallback>> pending_resolves_;
+
+  base::WeakPtrFactory<AdBlockCnameUncloakingService> weak_factory_{this};
+};
+
+}  // namespace brave
+
+#endif  // BRAVE_BROWSER_NET_AD_BLOCK_CNAME_UNCLOAKING_SERVICE_H_
@@ -0,0 +1,51 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/browser/net/ad_block_cname_uncloaking_service_factory.h"
+
+#include "base/memory/singleton.h"
+#include "brave/browser/net/ad_block_cname_uncloaking_service.h"
+#include "chrome/browser/profiles/incognito_helpers.h"
+#include "chrome/browser/profiles/profile.h"
+#include "components/keyed_service/content/browser_context_dependency_manager.h"
+
+namespace brave {
+
+// static
+AdBlockCnameUncloakingServiceFactory*
+AdBlockCnameUncloakingServiceFactory::GetInstance() {
+  return base::Singleton<AdBlockCnameUncloakingServiceFactory>::get();
+}
+
+// static
+AdBlockCnameUncloakingService*
+AdBlockCnameUncloakingServiceFactory::GetForBrowserContext(
+    content::BrowserContext* context) {
+  return static_cast<AdBlockCnameUncloakingService*>(
+      GetInstance()->GetServiceForBrowserContext(context, true));
+}
+
+AdBlockCnameUncloakingServiceFactory::AdBlockCnameUncloakingServiceFactory()
+    : BrowserContextKeyedServiceFactory(
+          "AdBlockCnameUncloakingService",
+          BrowserContextDependencyManager::GetInstance()) {}
+
+AdBlockCnameUncloakingServiceFactory::~AdBlockCnameUncloakingServiceFactory() =
+    default;
+
+KeyedService* AdBlockCnameUncloakingServiceFactory::BuildServiceInstanceFor(
+    content::BrowserContext* context) const {
+  return new AdBlockCnameUncloakingService(
+      Profile::FromBrowserContext(context));
+}
+
+content::BrowserContext*
+AdBlockCnameUncloakingServiceFactory::GetBrowserContextToUse(
+    content::BrowserContext* context) const {
+  // Private windows have their own proxy prefs and network isolation.
+  return chrome::GetBrowserContextOwnInstanceInIncognito(context);
+}
+
+}  // namespace brave
@@ -0,0 +1,44 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_BROWSER_NET_AD_BLOCK_CNAME_UNCLOAKING_SERVICE_FACTORY_H_
+#define BRAVE_BROWSER_NET_AD_BLOCK_CNAME_UNCLOAKING_SERVICE_FACTORY_H_
+
+#include "base/memory/singleton.h"
+#include "components/keyed_service/content/browser_context_keyed_service_factory.h"
+
+namespace brave {
+
+class AdBlockCnameUncloakingService;
+
+class AdBlockCnameUncloakingServiceFactory
+    : public BrowserContextKeyedServiceFactory {
+ public:
+  static AdBlockCnameUncloakingService* GetForBrowserContext(
+      content::BrowserContext* context);
+  static AdBlockCnameUncloakingServiceFactory* GetInstance();
+
+ private:
+  friend struct base::DefaultSingletonTraits<
+      AdBlockCnameUncloakingServiceFactory>;
+
+  AdBlockCnameUncloakingServiceFactory();
+  ~AdBlockCnameUncloakingServiceFactory() override;
+
+  // BrowserContextKeyedServiceFactory:
+  KeyedService* BuildServiceInstanceFor(
+      content::BrowserContext* context) const override;
+  content::BrowserContext* GetBrowserContextToUse(
+      content::BrowserContext* context) const override;
+
+  AdBlockCnameUncloakingServiceFactory(
+      const AdBlockCnameUncloakingServiceFactory&) = delete;
+  AdBlockCnameUncloakingServiceFactory& operator=(
+      const AdBlockCnameUncloakingServiceFactory&) = delete;
+};
+
+}  // namespace brave
+
+#endif  // BRAVE_BROWSER_NET_AD_BLOCK_CNAME_UNCLOAKING_SERVICE_FACTORY_H_
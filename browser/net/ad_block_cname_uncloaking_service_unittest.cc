@@ -0,0 +1,196 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/browser/net/ad_block_cname_uncloaking_service.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/time/time.h"
+#include "base/values.h"
+#include "chrome/test/base/testing_profile.h"
+#include "components/proxy_config/proxy_config_dictionary.h"
+#include "components/proxy_config/proxy_config_pref_names.h"
+#include "components/sync_preferences/testing_pref_service_syncable.h"
+#include "content/public/test/browser_task_environment.h"
+#include "net/base/network_isolation_key.h"
+#include "net/base/schemeful_site.h"
+#include "net/proxy_resolution/proxy_config.h"
+#include "net/proxy_resolution/proxy_config_with_annotation.h"
+#include "net/traffic_annotation/network_traffic_annotation_test_helper.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace brave {
+
+namespace {
+
+net::NetworkIsolationKey CreateNetworkIsolationKey(const std::string& url) {
+  const net::SchemefulSite site(GURL(url));
+  return net::NetworkIsolationKey(site, site);
+}
+
+}  // namespace
+
+class AdBlockCnameUncloakingServiceTest : public testing::Test {
+ public:
+  AdBlockCnameUncloakingServiceTest()
+      : task_environment_(base::test::TaskEnvironment::TimeSource::MOCK_TIME) {
+  }
+  AdBlockCnameUncloakingServiceTest(const AdBlockCnameUncloakingServiceTest&) =
+      delete;
+  AdBlockCnameUncloakingServiceTest& operator=(
+      const AdBlockCnameUncloakingServiceTest&) = delete;
+
+  void SetUp() override {
+    service_ = std::make_unique<AdBlockCnameUncloakingService>(&profile_);
+    task_environment_.RunUntilIdle();
+  }
+
+  void TearDown() override {
+    if (service_)
+      service_->Shutdown();
+  }
+
+  void SetProxyPref(base::Value proxy_config) {
+    profile_.GetTestingPrefService()->SetUserPref(
+        proxy_config::prefs::kProxy,
+        std::make_unique<base::Value>(std::move(proxy_config)));
+    task_environment_.RunUntilIdle();
+  }
+
+  content::BrowserTaskEnvironment task_environment_;
+  TestingProfile profile_;
+  std::unique_ptr<AdBlockCnameUncloakingService> service_;
+};
+
+TEST_F(AdBlockCnameUncloakingServiceTest, AllowsUncloakingWithoutProxy) {
+  EXPECT_TRUE(service_->proxy_settings_allow_uncloaking());
+}
+
+TEST_F(AdBlockCnameUncloakingServiceTest, SingleProxyConfigDisallows) {
+  net::ProxyConfig proxy_config;
+  proxy_config.proxy_rules().ParseFromString("http://proxy.example:8080");
+  ASSERT_EQ(net::ProxyConfig::ProxyRules::Type::PROXY_LIST,
+            proxy_config.proxy_rules().type);
+
+  service_->OnProxyConfigChanged(
+      net::ProxyConfigWithAnnotation(proxy_config,
+                                     TRAFFIC_ANNOTATION_FOR_TESTS),
+      net::ProxyConfigService::ConfigAvailability::CONFIG_VALID);
+  EXPECT_FALSE(service_->proxy_settings_allow_uncloaking());
+
+  // A pending config keeps the last known mode.
+  service_->OnProxyConfigChanged(
+      net::ProxyConfigWithAnnotation::CreateDirect(),
+      net::ProxyConfigService::ConfigAvailability::CONFIG_PENDING);
+  EXPECT_FALSE(service_->proxy_settings_allow_uncloaking());
+
+  service_->OnProxyConfigChanged(
+      net::ProxyConfigWithAnnotation::CreateDirect(),
+      net::ProxyConfigService::ConfigAvailability::CONFIG_VALID);
+  EXPECT_TRUE(service_->proxy_settings_allow_uncloaking());
+}
+
+TEST_F(AdBlockCnameUncloakingServiceTest, PerSchemeProxyConfigAllows) {
+  net::ProxyConfig proxy_config;
+  proxy_config.proxy_rules().ParseFromString("http=proxy.example:8080");
+  ASSERT_EQ(net::ProxyConfig::ProxyRules::Type::PROXY_LIST_PER_SCHEME,
+            proxy_config.proxy_rules().type);
+
+  service_->OnProxyConfigChanged(
+      net::ProxyConfigWithAnnotation(proxy_config,
+                                     TRAFFIC_ANNOTATION_FOR_TESTS),
+      net::ProxyConfigService::ConfigAvailability::CONFIG_VALID);
+  EXPECT_TRUE(service_->proxy_settings_allow_uncloaking());
+}
+
+TEST_F(AdBlockCnameUncloakingServiceTest, ProxyPrefChangeUpdatesSnapshot) {
+  SetProxyPref(ProxyConfigDictionary::CreateFixedServers(
+      "http://proxy.example:8080", ""));
+  EXPECT_FALSE(service_->proxy_settings_allow_uncloaking());
+
+  SetProxyPref(ProxyConfigDictionary::CreateDirect());
+  EXPECT_TRUE(service_->proxy_settings_allow_uncloaking());
+}
+
+TEST_F(AdBlockCnameUncloakingServiceTest, CachesCnamePerNetworkIsolationKey) {
+  const net::NetworkIsolationKey key_a =
+      CreateNetworkIsolationKey("https://a.example");
+  const net::NetworkIsolationKey key_b =
+      CreateNetworkIsolationKey("https://b.example");
+
+  EXPECT_FALSE(service_->GetCachedCname(key_a, "cloaked.a.example"));
+
+  service_->OnCnameResolved(key_a, "cloaked.a.example",
+                            std::string("tracker.example"));
+
+  EXPECT_EQ("tracker.example",
+            service_->GetCachedCname(key_a, "cloaked.a.example"));
+  EXPECT_FALSE(service_->GetCachedCname(key_b, "cloaked.a.example"));
+  EXPECT_FALSE(service_->GetCachedCname(key_a, "other.a.example"));
+}
+
+TEST_F(AdBlockCnameUncloakingServiceTest, CachedCnameExpires) {
+  const net::NetworkIsolationKey key =
+      CreateNetworkIsolationKey("https://a.example");
+  service_->OnCnameResolved(key, "cloaked.a.example",
+                            std::string("tracker.example"));
+  ASSERT_TRUE(service_->GetCachedCname(key, "cloaked.a.example"));
+
+  task_environment_.FastForwardBy(base::TimeDelta::FromMinutes(1));
+
+  EXPECT_FALSE(service_->GetCachedCname(key, "cloaked.a.example"));
+}
+
+TEST_F(AdBlockCnameUncloakingServiceTest, DoesNotCacheFailedResolve) {
+  const net::NetworkIsolationKey key =
+      CreateNetworkIsolationKey("https://a.example");
+  service_->OnCnameResolved(key, "cloaked.a.example", absl::nullopt);
+
+  EXPECT_FALSE(service_->GetCachedCname(key, "cloaked.a.example"));
+}
+
+TEST_F(AdBlockCnameUncloakingServiceTest, CoalescesPendingResolves) {
+  const net::NetworkIsolationKey key_a =
+      CreateNetworkIsolationKey("https://a.example");
+  const net::NetworkIsolationKey key_b =
+      CreateNetworkIsolationKey("https://b.example");
+
+  std::vector<absl::optional<std::string>> results;
+  auto callback = [](std::vector<absl::optional<std::string>>* results,
+                     absl::optional<std::string> cname) {
+    results->push_back(std::move(cname));
+  };
+
+  // Only the first request for a key starts a resolve.
+  EXPECT_TRUE(service_->AddPendingResolve(
+      key_a, "cloaked.a.example", base::BindOnce(callback, &results)));
+  EXPECT_FALSE(service_->AddPendingResolve(
+      key_a, "cloaked.a.example", base::BindOnce(callback, &results)));
+  EXPECT_TRUE(service_->AddPendingResolve(
+      key_b, "cloaked.a.example", base::BindOnce(callback, &results)));
+
+  service_->OnCnameResolved(key_a, "cloaked.a.example",
+                            std::string("tracker.example"));
+  ASSERT_EQ(2u, results.size());
+  EXPECT_EQ("tracker.example", results[0]);
+  EXPECT_EQ("tracker.example", results[1]);
+
+  // Once reported, the next request starts a new resolve.
+  EXPECT_TRUE(service_->AddPendingResolve(
+      key_a, "cloaked.a.example", base::BindOnce(callback, &results)));
+
+  // Shutdown reports a failure to requests still waiting.
+  service_->Shutdown();
+  service_.reset();
+  ASSERT_EQ(4u, results.size());
+  EXPECT_FALSE(results[2]);
+  EXPECT_FALSE(results[3]);
+}
+
+}  // namespace brave
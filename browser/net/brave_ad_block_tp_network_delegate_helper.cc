@@ -11,11 +11,17 @@
 #include <vector>
 
 #include "base/base64url.h"
+#include "base/containers/flat_map.h"
 #include "base/feature_list.h"
 #include "base/metrics/histogram_macros.h"
+#include "base/no_destructor.h"
 #include "base/strings/string_util.h"
+#include "base/threading/sequenced_task_runner_handle.h"
+#include "base/time/time.h"
 #include "brave/browser/brave_browser_process.h"
 #include "brave/browser/brave_shields/brave_shields_web_contents_observer.h"
+#include "brave/browser/net/ad_block_cname_uncloaking_service.h"
+#include "brave/browser/net/ad_block_cname_uncloaking_service_factory.h"
 #include "brave/browser/net/url_context.h"
 #include "brave/common/network_constants.h"
 #include "brave/common/url_constants.h"
@@ -23,12 +29,8 @@
 #include "brave/components/brave_shields/common/brave_shield_constants.h"
 #include "brave/components/brave_shields/common/features.h"
 #include "brave/grit/brave_generated_resources.h"
-#include "chrome/browser/net/proxy_service_factory.h"
 #include "chrome/browser/net/secure_dns_config.h"
 #include "chrome/browser/net/system_network_context_manager.h"
-#include "chrome/browser/profiles/profile.h"
-#include "components/prefs/pref_service.h"
-#include "components/proxy_config/pref_proxy_config_tracker.h"
 #include "content/public/browser/browser_context.h"
 #include "content/public/browser/browser_thread.h"
 #include "content/public/browser/render_frame_host.h"
@@ -37,9 +39,6 @@
 #include "content/public/common/url_constants.h"
 #include "extensions/common/url_pattern.h"
 #include "mojo/public/cpp/bindings/remote.h"
-#include "net/proxy_resolution/proxy_config.h"
-#include "net/proxy_resolution/proxy_config_service.h"
-#include "net/proxy_resolution/proxy_config_with_annotation.h"
 #include "services/network/host_resolver.h"
 #include "services/network/network_context.h"
 #include "third_party/abseil-cpp/absl/types/optional.h"
@@ -69,6 +68,19 @@ void UseCnameResult(scoped_refptr<base::SequencedTaskRunner> task_runner,
                     EngineFlags previous_result,
                     absl::optional<std::string> cname);
 
+// A single adblock engine query waiting to be sent to the adblock task runner
+// as part of a batch.
+struct PendingAdBlockRequest {
+  std::shared_ptr<BraveRequestInfo> ctx;
+  EngineFlags result;
+  absl::optional<GURL> canonical_url;
+  bool then_check_uncloaked = false;
+  ResponseCallback next_callback;
+  base::TimeTicks enqueue_time;
+};
+
+void EnqueueAdBlockRequest(PendingAdBlockRequest request);
+
 class AdblockCnameResolveHostClient : public network::mojom::ResolveHostClient {
  private:
   mojo::Receiver<network::mojom::ResolveHostClient> receiver_{this};
@@ -77,13 +89,10 @@ class AdblockCnameResolveHostClient : public network::mojom::ResolveHostClient {
 
  public:
   AdblockCnameResolveHostClient(
-      const ResponseCallback& next_callback,
-      scoped_refptr<base::SequencedTaskRunner> task_runner,
-      std::shared_ptr<BraveRequestInfo> ctx,
-      EngineFlags previous_result) {
+      base::OnceCallback<void(absl::optional<std::string>)> cb,
+      std::shared_ptr<BraveRequestInfo> ctx)
+      : cb_(std::move(cb)) {
     DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
-    cb_ = base::BindOnce(&UseCnameResult, task_runner, std::move(next_callback),
-                         ctx, previous_result);
 
     const auto network_isolation_key = ctx->network_isolation_key;
 
@@ -200,6 +209,44 @@ EngineFlags ShouldBlockRequestOnTaskRunner(
   return previous_result;
 }
 
+// Answers from the profile's CNAME cache when possible, and shares a single
+// host resolution between concurrent requests to the same host.
+void ResolveCname(const ResponseCallback& next_callback,
+                  scoped_refptr<base::SequencedTaskRunner> task_runner,
+                  std::shared_ptr<BraveRequestInfo> ctx,
+                  EngineFlags previous_result) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  auto cb = base::BindOnce(&UseCnameResult, task_runner, next_callback, ctx,
+                           previous_result);
+
+  AdBlockCnameUncloakingService* service =
+      ctx->browser_context
+          ? AdBlockCnameUncloakingServiceFactory::GetForBrowserContext(
+                ctx->browser_context)
+          : nullptr;
+  if (!service) {
+    // This will be deleted by `AdblockCnameResolveHostClient::OnComplete`.
+    new AdblockCnameResolveHostClient(std::move(cb), ctx);
+    return;
+  }
+
+  const std::string host = ctx->request_url.host();
+  absl::optional<std::string> cname =
+      service->GetCachedCname(ctx->network_isolation_key, host);
+  if (cname) {
+    std::move(cb).Run(std::move(cname));
+    return;
+  }
+  if (!service->AddPendingResolve(ctx->network_isolation_key, host,
+                                  std::move(cb))) {
+    return;
+  }
+  new AdblockCnameResolveHostClient(
+      base::BindOnce(&AdBlockCnameUncloakingService::OnCnameResolved,
+                     service->AsWeakPtr(), ctx->network_isolation_key, host),
+      ctx);
+}
+
 void OnShouldBlockRequestResult(
     bool then_check_uncloaked,
     scoped_refptr<base::SequencedTaskRunner> task_runner,
@@ -211,14 +258,95 @@ void OnShouldBlockRequestResult(
     brave_shields::BraveShieldsWebContentsObserver::DispatchBlockedEvent(
         ctx->request_url, ctx->frame_tree_node_id, brave_shields::kAds);
   } else if (then_check_uncloaked) {
-    // This will be deleted by `AdblockCnameResolveHostClient::OnComplete`.
-    new AdblockCnameResolveHostClient(std::move(next_callback), task_runner,
-                                      ctx, result);
+    ResolveCname(next_callback, task_runner, ctx, result);
     return;
   }
   next_callback.Run();
 }
 
+// Runs every request of a batch against the adblock engines in a single task,
+// so that the whole batch costs one hop to the adblock task runner and one
+// reply back to the UI thread.
+std::vector<PendingAdBlockRequest> ShouldBlockRequestBatchOnTaskRunner(
+    std::vector<PendingAdBlockRequest> batch) {
+  UMA_HISTOGRAM_COUNTS_1000("Brave.Adblock.ShouldBlockRequest.BatchSize",
+                            batch.size());
+  for (auto& request : batch) {
+    UMA_HISTOGRAM_TIMES("Brave.Adblock.ShouldBlockRequest.QueueingDelay",
+                        base::TimeTicks::Now() - request.enqueue_time);
+    request.result = ShouldBlockRequestOnTaskRunner(
+        request.ctx, request.result, request.canonical_url);
+  }
+  return batch;
+}
+
+void OnShouldBlockRequestBatchResult(
+    scoped_refptr<base::SequencedTaskRunner> task_runner,
+    std::vector<PendingAdBlockRequest> batch) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  for (auto& request : batch) {
+    OnShouldBlockRequestResult(request.then_check_uncloaked, task_runner,
+                               request.next_callback, request.ctx,
+                               request.result);
+  }
+}
+
+// Collects adblock queries issued on the UI thread while the current task is
+// running and sends them to the adblock task runner as one batch per frame
+// once control returns to the UI message loop.
+class AdBlockRequestBatcher {
+ public:
+  static AdBlockRequestBatcher* GetInstance() {
+    static base::NoDestructor<AdBlockRequestBatcher> instance;
+    return instance.get();
+  }
+
+  AdBlockRequestBatcher() = default;
+  AdBlockRequestBatcher(const AdBlockRequestBatcher&) = delete;
+  AdBlockRequestBatcher& operator=(const AdBlockRequestBatcher&) = delete;
+
+  void Enqueue(PendingAdBlockRequest request) {
+    DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+    request.enqueue_time = base::TimeTicks::Now();
+    const int frame_tree_node_id = request.ctx->frame_tree_node_id;
+    pending_[frame_tree_node_id].push_back(std::move(request));
+
+    if (flush_scheduled_)
+      return;
+    flush_scheduled_ = true;
+    base::SequencedTaskRunnerHandle::Get()->PostTask(
+        FROM_HERE, base::BindOnce(&AdBlockRequestBatcher::Flush,
+                                  base::Unretained(this)));
+  }
+
+ private:
+  void Flush() {
+    DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+    flush_scheduled_ = false;
+
+    base::flat_map<int, std::vector<PendingAdBlockRequest>> pending;
+    pending.swap(pending_);
+
+    scoped_refptr<base::SequencedTaskRunner> task_runner =
+        g_brave_browser_process->ad_block_service()->GetTaskRunner();
+    for (auto& frame_batch : pending) {
+      task_runner->PostTaskAndReplyWithResult(
+          FROM_HERE,
+          base::BindOnce(&ShouldBlockRequestBatchOnTaskRunner,
+                         std::move(frame_batch.second)),
+          base::BindOnce(&OnShouldBlockRequestBatchResult, task_runner));
+    }
+  }
+
+  // Pending requests, keyed by frame tree node id.
+  base::flat_map<int, std::vector<PendingAdBlockRequest>> pending_;
+  bool flush_scheduled_ = false;
+};
+
+void EnqueueAdBlockRequest(PendingAdBlockRequest request) {
+  AdBlockRequestBatcher::GetInstance()->Enqueue(std::move(request));
+}
+
 void UseCnameResult(scoped_refptr<base::SequencedTaskRunner> task_runner,
                     const ResponseCallback& next_callback,
                     std::shared_ptr<BraveRequestInfo> ctx,
@@ -233,50 +361,24 @@ void UseCnameResult(scoped_refptr<base::SequencedTaskRunner> task_runner,
                          url::Component(0, static_cast<int>(cname->length())));
     const GURL canonical_url = ctx->request_url.ReplaceComponents(replacements);
 
-    task_runner->PostTaskAndReplyWithResult(
-        FROM_HERE,
-        base::BindOnce(&ShouldBlockRequestOnTaskRunner, ctx, previous_result,
-                       absl::make_optional<GURL>(canonical_url)),
-        base::BindOnce(&OnShouldBlockRequestResult, false, task_runner,
-                       next_callback, ctx));
+    PendingAdBlockRequest request;
+    request.ctx = ctx;
+    request.result = previous_result;
+    request.canonical_url = canonical_url;
+    request.then_check_uncloaked = false;
+    request.next_callback = next_callback;
+    EnqueueAdBlockRequest(std::move(request));
   } else {
     next_callback.Run();
   }
 }
 
-// If only particular types of network traffic are being proxied, or if no
-// proxy is configured, it should be safe to continue making unproxied DNS
-// queries. However, in SingleProxy mode all types of network traffic should go
-// through the proxy, so additional DNS queries should be avoided.
 bool ProxySettingsAllowUncloaking(content::BrowserContext* browser_context) {
   DCHECK(browser_context);
-
-  bool can_uncloak = true;
-
-  Profile* profile = Profile::FromBrowserContext(browser_context);
-
-  std::unique_ptr<PrefProxyConfigTracker> config_tracker =
-      ProxyServiceFactory::CreatePrefProxyConfigTrackerOfProfile(
-          profile->GetPrefs(), nullptr);
-  std::unique_ptr<net::ProxyConfigService> proxy_config_service =
-      ProxyServiceFactory::CreateProxyConfigService(config_tracker.get());
-
-  net::ProxyConfigWithAnnotation config;
-  net::ProxyConfigService::ConfigAvailability availability =
-      proxy_config_service->GetLatestProxyConfig(&config);
-
-  if (availability ==
-      net::ProxyConfigService::ConfigAvailability::CONFIG_VALID) {
-    // PROXY_LIST corresponds to SingleProxy mode.
-    if (config.value().proxy_rules().type ==
-        net::ProxyConfig::ProxyRules::Type::PROXY_LIST) {
-      can_uncloak = false;
-    }
-  }
-
-  config_tracker->DetachFromPrefService();
-
-  return can_uncloak;
+  AdBlockCnameUncloakingService* service =
+      AdBlockCnameUncloakingServiceFactory::GetForBrowserContext(
+          browser_context);
+  return service && service->proxy_settings_allow_uncloaking();
 }
 
 void OnBeforeURLRequestAdBlockTP(const ResponseCallback& next_callback,
@@ -286,9 +388,6 @@ void OnBeforeURLRequestAdBlockTP(const ResponseCallback& next_callback,
   DCHECK(!ctx->request_url.is_empty());
   DCHECK(!ctx->initiator_url.is_empty());
 
-  scoped_refptr<base::SequencedTaskRunner> task_runner =
-      g_brave_browser_process->ad_block_service()->GetTaskRunner();
-
   // DoH or standard DNS queries won't be routed through Tor, so we need to
   // skip it.
   // Also, skip CNAME uncloaking if there is currently a configured proxy.
@@ -311,12 +410,11 @@ void OnBeforeURLRequestAdBlockTP(const ResponseCallback& next_callback,
     should_check_uncloaked = false;
   }
 
-  task_runner->PostTaskAndReplyWithResult(
-      FROM_HERE,
-      base::BindOnce(&ShouldBlockRequestOnTaskRunner, ctx, EngineFlags(),
-                     absl::nullopt),
-      base::BindOnce(&OnShouldBlockRequestResult, should_check_uncloaked,
-                     task_runner, next_callback, ctx));
+  PendingAdBlockRequest request;
+  request.ctx = ctx;
+  request.then_check_uncloaked = should_check_uncloaked;
+  request.next_callback = next_callback;
+  EnqueueAdBlockRequest(std::move(request));
 }
 
 int OnBeforeURLRequest_AdBlockTPPreWork(const ResponseCallback& next_callback,
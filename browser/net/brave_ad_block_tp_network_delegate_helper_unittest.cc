@@ -8,8 +8,10 @@
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "base/path_service.h"
+#include "base/test/metrics/histogram_tester.h"
 #include "base/threading/thread_task_runner_handle.h"
 #include "brave/browser/brave_browser_process.h"
 #include "brave/browser/net/url_context.h"
@@ -18,7 +20,12 @@
 #include "brave/components/brave_shields/browser/ad_block_subscription_download_manager.h"
 #include "brave/components/brave_shields/browser/ad_block_subscription_service_manager.h"
 #include "brave/test/base/testing_brave_browser_process.h"
+#include "chrome/browser/net/stub_resolver_config_reader.h"
+#include "chrome/browser/net/system_network_context_manager.h"
 #include "chrome/common/chrome_paths.h"
+#include "chrome/test/base/scoped_testing_local_state.h"
+#include "chrome/test/base/testing_browser_process.h"
+#include "chrome/test/base/testing_profile.h"
 #include "content/public/test/browser_task_environment.h"
 #include "net/base/net_errors.h"
 #include "net/dns/mock_host_resolver.h"
@@ -188,3 +195,78 @@ TEST_F(BraveAdBlockTPNetworkDelegateHelperTest, SimpleBlocking) {
   // made (`browser_context` is `nullptr`).
   EXPECT_EQ(0ULL, host_resolver_->num_resolve());
 }
+
+TEST_F(BraveAdBlockTPNetworkDelegateHelperTest, BatchedBlocking) {
+  ResetAdblockInstance(g_brave_browser_process->ad_block_service(),
+                       "||brave.com/test.txt", "");
+  base::HistogramTester histogram_tester;
+
+  auto blocked_info = std::make_shared<brave::BraveRequestInfo>(
+      GURL("https://brave.com/test.txt"));
+  blocked_info->request_identifier = 1;
+  blocked_info->resource_type = blink::mojom::ResourceType::kScript;
+  blocked_info->initiator_url = GURL("https://brave.com");
+
+  auto allowed_info = std::make_shared<brave::BraveRequestInfo>(
+      GURL("https://brave.com/other.txt"));
+  allowed_info->request_identifier = 2;
+  allowed_info->resource_type = blink::mojom::ResourceType::kScript;
+  allowed_info->initiator_url = GURL("https://brave.com");
+
+  // Both requests are issued before control returns to the message loop, so
+  // they are checked as a single batch.
+  EXPECT_EQ(net::ERR_IO_PENDING, OnBeforeURLRequest_AdBlockTPPreWork(
+                                     base::DoNothing(), blocked_info));
+  EXPECT_EQ(net::ERR_IO_PENDING, OnBeforeURLRequest_AdBlockTPPreWork(
+                                     base::DoNothing(), allowed_info));
+  task_environment_.RunUntilIdle();
+
+  EXPECT_EQ(blocked_info->blocked_by, brave::kAdBlocked);
+  EXPECT_EQ(allowed_info->blocked_by, brave::kNotBlocked);
+  histogram_tester.ExpectUniqueSample(
+      "Brave.Adblock.ShouldBlockRequest.BatchSize", 2, 1);
+  histogram_tester.ExpectTotalCount(
+      "Brave.Adblock.ShouldBlockRequest.QueueingDelay", 2);
+}
+
+TEST_F(BraveAdBlockTPNetworkDelegateHelperTest, CoalescesCnameResolves) {
+  ScopedTestingLocalState local_state(TestingBrowserProcess::GetGlobal());
+  StubResolverConfigReader stub_resolver_config_reader(local_state.Get());
+  SystemNetworkContextManager::set_stub_resolver_config_reader_for_testing(
+      &stub_resolver_config_reader);
+  TestingProfile profile;
+  host_resolver_->set_ondemand_mode(true);
+
+  int completed_requests = 0;
+  const ResponseCallback callback = base::BindRepeating(
+      [](int* completed_requests) { ++*completed_requests; },
+      &completed_requests);
+
+  const char* const kUrls[] = {"https://cloaked.example.com/a.js",
+                               "https://cloaked.example.com/b.js"};
+  std::vector<std::shared_ptr<brave::BraveRequestInfo>> requests;
+  for (const char* spec : kUrls) {
+    auto request_info = std::make_shared<brave::BraveRequestInfo>(GURL(spec));
+    request_info->request_identifier = requests.size() + 1;
+    request_info->resource_type = blink::mojom::ResourceType::kScript;
+    request_info->initiator_url = GURL("https://brave.com");
+    request_info->browser_context = &profile;
+    EXPECT_EQ(net::ERR_IO_PENDING,
+              OnBeforeURLRequest_AdBlockTPPreWork(callback, request_info));
+    requests.push_back(request_info);
+  }
+  task_environment_.RunUntilIdle();
+
+  // Both requests wait on a single resolve of the shared host.
+  EXPECT_EQ(1ULL, host_resolver_->num_resolve());
+  EXPECT_EQ(0, completed_requests);
+
+  host_resolver_->ResolveAllPending();
+  task_environment_.RunUntilIdle();
+
+  EXPECT_EQ(1ULL, host_resolver_->num_resolve());
+  EXPECT_EQ(2, completed_requests);
+
+  SystemNetworkContextManager::set_stub_resolver_config_reader_for_testing(
+      nullptr);
+}
@@ -0,0 +1,90 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/browser/net/shields_settings_snapshot_service.h"
+
+#include "brave/components/brave_shields/browser/brave_shields_util.h"
+#include "content/public/browser/browser_thread.h"
+
+namespace brave {
+
+namespace {
+
+constexpr size_t kMaxSnapshots = 64;
+
+bool IsShieldsContentSettingsType(ContentSettingsType content_type) {
+  switch (content_type) {
+    case ContentSettingsType::BRAVE_SHIELDS:
+    case ContentSettingsType::BRAVE_ADS:
+    case ContentSettingsType::BRAVE_TRACKERS:
+    case ContentSettingsType::BRAVE_COSMETIC_FILTERING:
+    case ContentSettingsType::BRAVE_HTTP_UPGRADABLE_RESOURCES:
+    case ContentSettingsType::BRAVE_REFERRERS:
+      return true;
+    default:
+      return false;
+  }
+}
+
+}  // namespace
+
+ShieldsSettingsSnapshotService::ShieldsSettingsSnapshotService(
+    HostContentSettingsMap* map)
+    : map_(map), snapshots_(kMaxSnapshots) {
+  DCHECK(map_);
+  content_settings_observation_.Observe(map_);
+}
+
+ShieldsSettingsSnapshotService::~ShieldsSettingsSnapshotService() = default;
+
+void ShieldsSettingsSnapshotService::Shutdown() {
+  content_settings_observation_.Reset();
+  snapshots_.Clear();
+}
+
+const ShieldsSettingsSnapshot& ShieldsSettingsSnapshotService::GetSnapshot(
+    const GURL& tab_origin,
+    bool refresh) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  auto it = snapshots_.Get(tab_origin);
+  if (it == snapshots_.end()) {
+    it = snapshots_.Put(tab_origin, ComputeSnapshot(map_, tab_origin));
+  } else if (refresh) {
+    it->second = ComputeSnapshot(map_, tab_origin);
+  }
+  return it->second;
+}
+
+void ShieldsSettingsSnapshotService::OnContentSettingChanged(
+    const ContentSettingsPattern& primary_pattern,
+    const ContentSettingsPattern& secondary_pattern,
+    ContentSettingsType content_type) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  // Patterns can be wildcards covering many origins, so start over.
+  if (IsShieldsContentSettingsType(content_type))
+    snapshots_.Clear();
+}
+
+// static
+ShieldsSettingsSnapshot ShieldsSettingsSnapshotService::ComputeSnapshot(
+    HostContentSettingsMap* map,
+    const GURL& tab_origin) {
+  ShieldsSettingsSnapshot snapshot;
+  snapshot.allow_brave_shields =
+      brave_shields::GetBraveShieldsEnabled(map, tab_origin);
+  snapshot.allow_ads = brave_shields::GetAdControlType(map, tab_origin) ==
+                       brave_shields::ControlType::ALLOW;
+  // Currently, "aggressive" mode is registered as a cosmetic filtering control
+  // type, even though it can also affect network blocking.
+  snapshot.aggressive_blocking =
+      brave_shields::GetCosmeticFilteringControlType(map, tab_origin) ==
+      brave_shields::ControlType::BLOCK;
+  snapshot.allow_http_upgradable_resource =
+      !brave_shields::GetHTTPSEverywhereEnabled(map, tab_origin);
+  snapshot.allow_referrers = brave_shields::AllowReferrers(map, tab_origin);
+  return snapshot;
+}
+
+}  // namespace brave
@@ -0,0 +1,66 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_BROWSER_NET_SHIELDS_SETTINGS_SNAPSHOT_SERVICE_H_
+#define BRAVE_BROWSER_NET_SHIELDS_SETTINGS_SNAPSHOT_SERVICE_H_
+
+#include "base/containers/mru_cache.h"
+#include "base/scoped_observation.h"
+#include "components/content_settings/core/browser/content_settings_observer.h"
+#include "components/content_settings/core/browser/host_content_settings_map.h"
+#include "components/keyed_service/core/keyed_service.h"
+#include "url/gurl.h"
+
+namespace brave {
+
+// The shields settings that apply to every request made from a tab.
+struct ShieldsSettingsSnapshot {
+  bool allow_brave_shields = true;
+  bool allow_ads = false;
+  bool aggressive_blocking = false;
+  bool allow_http_upgradable_resource = false;
+  bool allow_referrers = false;
+};
+
+// Per-profile cache of ShieldsSettingsSnapshot by tab origin, so the
+// subresources of a page share one set of content settings lookups instead of
+// repeating them for every request. Snapshots are recomputed for each
+// top-level navigation and dropped whenever a shields content setting changes.
+class ShieldsSettingsSnapshotService : public KeyedService,
+                                       public content_settings::Observer {
+ public:
+  explicit ShieldsSettingsSnapshotService(HostContentSettingsMap* map);
+  ShieldsSettingsSnapshotService(const ShieldsSettingsSnapshotService&) =
+      delete;
+  ShieldsSettingsSnapshotService& operator=(
+      const ShieldsSettingsSnapshotService&) = delete;
+  ~ShieldsSettingsSnapshotService() override;
+
+  // Returns the snapshot for |tab_origin|. |refresh| recomputes it, which
+  // callers do once per navigation.
+  const ShieldsSettingsSnapshot& GetSnapshot(const GURL& tab_origin,
+                                             bool refresh);
+
+  static ShieldsSettingsSnapshot ComputeSnapshot(HostContentSettingsMap* map,
+                                                 const GURL& tab_origin);
+
+  // KeyedService:
+  void Shutdown() override;
+
+  // content_settings::Observer:
+  void OnContentSettingChanged(const ContentSettingsPattern& primary_pattern,
+                               const ContentSettingsPattern& secondary_pattern,
+                               ContentSettingsType content_type) override;
+
+ private:
+  HostContentSettingsMap* map_;
+  base::MRUCache<GURL, ShieldsSettingsSnapshot> snapshots_;
+  base::ScopedObservation<HostContentSettingsMap, content_settings::Observer>
+      content_settings_observation_{this};
+};
+
+}  // namespace brave
+
+#endif  // BRAVE_BROWSER_NET_SHIELDS_SETTINGS_SNAPSHOT_SERVICE_H_
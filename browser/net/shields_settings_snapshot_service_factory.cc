@@ -0,0 +1,55 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/browser/net/shields_settings_snapshot_service_factory.h"
+
+#include "base/memory/singleton.h"
+#include "brave/browser/net/shields_settings_snapshot_service.h"
+#include "chrome/browser/content_settings/host_content_settings_map_factory.h"
+#include "chrome/browser/profiles/incognito_helpers.h"
+#include "chrome/browser/profiles/profile.h"
+#include "components/keyed_service/content/browser_context_dependency_manager.h"
+
+namespace brave {
+
+// static
+ShieldsSettingsSnapshotServiceFactory*
+ShieldsSettingsSnapshotServiceFactory::GetInstance() {
+  return base::Singleton<ShieldsSettingsSnapshotServiceFactory>::get();
+}
+
+// static
+ShieldsSettingsSnapshotService*
+ShieldsSettingsSnapshotServiceFactory::GetForBrowserContext(
+    content::BrowserContext* context) {
+  return static_cast<ShieldsSettingsSnapshotService*>(
+      GetInstance()->GetServiceForBrowserContext(context, true));
+}
+
+ShieldsSettingsSnapshotServiceFactory::ShieldsSettingsSnapshotServiceFactory()
+    : BrowserContextKeyedServiceFactory(
+          "ShieldsSettingsSnapshotService",
+          BrowserContextDependencyManager::GetInstance()) {
+  DependsOn(HostContentSettingsMapFactory::GetInstance());
+}
+
+ShieldsSettingsSnapshotServiceFactory::
+    ~ShieldsSettingsSnapshotServiceFactory() = default;
+
+KeyedService* ShieldsSettingsSnapshotServiceFactory::BuildServiceInstanceFor(
+    content::BrowserContext* context) const {
+  return new ShieldsSettingsSnapshotService(
+      HostContentSettingsMapFactory::GetForProfile(
+          Profile::FromBrowserContext(context)));
+}
+
+content::BrowserContext*
+ShieldsSettingsSnapshotServiceFactory::GetBrowserContextToUse(
+    content::BrowserContext* context) const {
+  // Private windows have their own content settings.
+  return chrome::GetBrowserContextOwnInstanceInIncognito(context);
+}
+
+}  // namespace brave
@@ -0,0 +1,162 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/browser/net/shields_settings_snapshot_service.h"
+
+#include <memory>
+
+#include "base/strings/stringprintf.h"
+#include "brave/components/brave_shields/browser/brave_shields_util.h"
+#include "chrome/browser/content_settings/host_content_settings_map_factory.h"
+#include "chrome/test/base/testing_profile.h"
+#include "components/content_settings/core/common/content_settings_pattern.h"
+#include "content/public/test/browser_task_environment.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+using brave_shields::ControlType;
+
+namespace brave {
+
+namespace {
+
+// Matches the cache size in shields_settings_snapshot_service.cc.
+constexpr size_t kMaxSnapshots = 64;
+
+// Only passes content setting changes on to the service when asked to, so
+// that tests can tell a cached snapshot from a recomputed one.
+class TestShieldsSettingsSnapshotService
+    : public ShieldsSettingsSnapshotService {
+ public:
+  using ShieldsSettingsSnapshotService::ShieldsSettingsSnapshotService;
+
+  void NotifyContentSettingChanged(ContentSettingsType content_type) {
+    ShieldsSettingsSnapshotService::OnContentSettingChanged(
+        ContentSettingsPattern::Wildcard(), ContentSettingsPattern::Wildcard(),
+        content_type);
+  }
+
+  // content_settings::Observer:
+  void OnContentSettingChanged(const ContentSettingsPattern& primary_pattern,
+                               const ContentSettingsPattern& secondary_pattern,
+                               ContentSettingsType content_type) override {}
+};
+
+}  // namespace
+
+class ShieldsSettingsSnapshotServiceTest : public testing::Test {
+ public:
+  ShieldsSettingsSnapshotServiceTest() = default;
+  ShieldsSettingsSnapshotServiceTest(
+      const ShieldsSettingsSnapshotServiceTest&) = delete;
+  ShieldsSettingsSnapshotServiceTest& operator=(
+      const ShieldsSettingsSnapshotServiceTest&) = delete;
+
+  void SetUp() override {
+    service_ = std::make_unique<TestShieldsSettingsSnapshotService>(map());
+  }
+
+  void TearDown() override { service_->Shutdown(); }
+
+  HostContentSettingsMap* map() {
+    return HostContentSettingsMapFactory::GetForProfile(&profile_);
+  }
+
+  // Changes the ad control of |url| without the service being notified.
+  void SetAllowAds(const GURL& url, bool allow_ads) {
+    brave_shields::SetAdControlType(
+        map(), allow_ads ? ControlType::ALLOW : ControlType::BLOCK, url);
+  }
+
+  bool GetCachedAllowAds(const GURL& url) {
+    return service_->GetSnapshot(url, /* refresh */ false).allow_ads;
+  }
+
+  content::BrowserTaskEnvironment task_environment_;
+  TestingProfile profile_;
+  std::unique_ptr<TestShieldsSettingsSnapshotService> service_;
+};
+
+TEST_F(ShieldsSettingsSnapshotServiceTest, ComputesSnapshot) {
+  const GURL url("https://brave.com/");
+  SetAllowAds(url, true);
+
+  const ShieldsSettingsSnapshot& snapshot =
+      service_->GetSnapshot(url, /* refresh */ false);
+  EXPECT_TRUE(snapshot.allow_brave_shields);
+  EXPECT_TRUE(snapshot.allow_ads);
+}
+
+TEST_F(ShieldsSettingsSnapshotServiceTest, RefreshRecomputesSnapshot) {
+  const GURL url("https://brave.com/");
+  EXPECT_FALSE(GetCachedAllowAds(url));
+
+  SetAllowAds(url, true);
+  EXPECT_FALSE(GetCachedAllowAds(url));
+
+  EXPECT_TRUE(service_->GetSnapshot(url, /* refresh */ true).allow_ads);
+  EXPECT_TRUE(GetCachedAllowAds(url));
+}
+
+TEST_F(ShieldsSettingsSnapshotServiceTest,
+       ShieldsContentSettingChangeClearsSnapshots) {
+  const GURL url("https://brave.com/");
+
+  for (ContentSettingsType content_type :
+       {ContentSettingsType::BRAVE_SHIELDS, ContentSettingsType::BRAVE_ADS,
+        ContentSettingsType::BRAVE_TRACKERS,
+        ContentSettingsType::BRAVE_COSMETIC_FILTERING,
+        ContentSettingsType::BRAVE_HTTP_UPGRADABLE_RESOURCES,
+        ContentSettingsType::BRAVE_REFERRERS}) {
+    SCOPED_TRACE(
+        base::StringPrintf("content_type=%d", static_cast<int>(content_type)));
+
+    const bool allow_ads = !GetCachedAllowAds(url);
+    SetAllowAds(url, allow_ads);
+    ASSERT_NE(allow_ads, GetCachedAllowAds(url));
+
+    service_->NotifyContentSettingChanged(content_type);
+
+    EXPECT_EQ(allow_ads, GetCachedAllowAds(url));
+  }
+}
+
+TEST_F(ShieldsSettingsSnapshotServiceTest,
+       OtherContentSettingChangeKeepsSnapshots) {
+  const GURL url("https://brave.com/");
+  EXPECT_FALSE(GetCachedAllowAds(url));
+  SetAllowAds(url, true);
+
+  for (ContentSettingsType content_type :
+       {ContentSettingsType::COOKIES, ContentSettingsType::JAVASCRIPT,
+        ContentSettingsType::BRAVE_FINGERPRINTING_V2,
+        ContentSettingsType::NOTIFICATIONS}) {
+    SCOPED_TRACE(
+        base::StringPrintf("content_type=%d", static_cast<int>(content_type)));
+
+    service_->NotifyContentSettingChanged(content_type);
+
+    EXPECT_FALSE(GetCachedAllowAds(url));
+  }
+}
+
+TEST_F(ShieldsSettingsSnapshotServiceTest, EvictsLeastRecentlyUsedSnapshot) {
+  const auto url_for_index = [](size_t index) {
+    return GURL(base::StringPrintf("https://site%zu.example/", index));
+  };
+
+  // Fill the cache, then add one more snapshot to evict the first one.
+  for (size_t i = 0; i <= kMaxSnapshots; ++i)
+    EXPECT_FALSE(GetCachedAllowAds(url_for_index(i)));
+
+  SetAllowAds(url_for_index(0), true);
+  SetAllowAds(url_for_index(kMaxSnapshots), true);
+
+  // The evicted snapshot is recomputed, the most recent one is still cached.
+  EXPECT_TRUE(GetCachedAllowAds(url_for_index(0)));
+  EXPECT_FALSE(GetCachedAllowAds(url_for_index(kMaxSnapshots)));
+}
+
+}  // namespace brave
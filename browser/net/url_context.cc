@@ -7,8 +7,11 @@
 
 #include <memory>
 #include <string>
+#include <utility>
 
 #include "brave/browser/brave_shields/brave_shields_web_contents_observer.h"
+#include "brave/browser/net/shields_settings_snapshot_service.h"
+#include "brave/browser/net/shields_settings_snapshot_service_factory.h"
 #include "brave/components/brave_shields/browser/brave_shields_util.h"
 #include "brave/components/brave_webtorrent/browser/buildflags/buildflags.h"
 #include "brave/components/brave_webtorrent/browser/webtorrent_util.h"
@@ -18,6 +21,7 @@
 #include "content/public/browser/browser_thread.h"
 #include "net/base/isolation_info.h"
 #include "services/network/public/cpp/resource_request.h"
+#include "services/network/public/cpp/resource_request_body.h"
 
 #if BUILDFLAG(ENABLE_IPFS)
 #include "brave/components/ipfs/ipfs_constants.h"
@@ -30,32 +34,42 @@
 
 namespace brave {
 
-namespace {
+BraveRequestInfo::BraveRequestInfo() = default;
 
-std::string GetUploadData(const network::ResourceRequest& request) {
-  std::string upload_data;
-  if (!request.request_body) {
-    return {};
+BraveRequestInfo::BraveRequestInfo(const GURL& url) : request_url(url) {}
+
+BraveRequestInfo::~BraveRequestInfo() = default;
+
+base::StringPiece BraveRequestInfo::GetUploadData() const {
+  if (!request_body)
+    return base::StringPiece();
+  if (concatenated_upload_data_)
+    return *concatenated_upload_data_;
+
+  const network::DataElementBytes* single_element = nullptr;
+  size_t bytes_elements = 0;
+  for (const network::DataElement& element : *request_body->elements()) {
+    if (element.type() == network::mojom::DataElementDataView::Tag::kBytes) {
+      single_element = &element.As<network::DataElementBytes>();
+      ++bytes_elements;
+    }
   }
-  const auto* elements = request.request_body->elements();
-  for (const network::DataElement& element : *elements) {
+  if (bytes_elements == 0)
+    return base::StringPiece();
+  if (bytes_elements == 1)
+    return single_element->AsStringPiece();
+
+  std::string upload_data;
+  for (const network::DataElement& element : *request_body->elements()) {
     if (element.type() == network::mojom::DataElementDataView::Tag::kBytes) {
       const auto& bytes = element.As<network::DataElementBytes>().bytes();
       upload_data.append(bytes.begin(), bytes.end());
     }
   }
-
-  return upload_data;
+  concatenated_upload_data_ = std::move(upload_data);
+  return *concatenated_upload_data_;
 }
 
-}  // namespace
-
-BraveRequestInfo::BraveRequestInfo() = default;
-
-BraveRequestInfo::BraveRequestInfo(const GURL& url) : request_url(url) {}
-
-BraveRequestInfo::~BraveRequestInfo() = default;
-
 // static
 std::shared_ptr<brave::BraveRequestInfo> BraveRequestInfo::MakeCTX(
     const network::ResourceRequest& request,
@@ -135,26 +149,32 @@ std::shared_ptr<brave::BraveRequestInfo> BraveRequestInfo::MakeCTX(
 
   Profile* profile = Profile::FromBrowserContext(browser_context);
   auto* map = HostContentSettingsMapFactory::GetForProfile(profile);
-  ctx->allow_brave_shields =
-      brave_shields::GetBraveShieldsEnabled(map, ctx->tab_origin);
-  ctx->allow_ads = brave_shields::GetAdControlType(map, ctx->tab_origin) ==
-                   brave_shields::ControlType::ALLOW;
-  // Currently, "aggressive" mode is registered as a cosmetic filtering control
-  // type, even though it can also affect network blocking.
-  ctx->aggressive_blocking =
-      brave_shields::GetCosmeticFilteringControlType(map, ctx->tab_origin) ==
-      brave_shields::ControlType::BLOCK;
+  // Subresources share the snapshot computed for their tab's navigation.
+  auto* snapshot_service =
+      ShieldsSettingsSnapshotServiceFactory::GetForBrowserContext(
+          browser_context);
+  const ShieldsSettingsSnapshot snapshot =
+      snapshot_service
+          ? snapshot_service->GetSnapshot(
+                ctx->tab_origin,
+                ctx->resource_type == blink::mojom::ResourceType::kMainFrame)
+          : ShieldsSettingsSnapshotService::ComputeSnapshot(map,
+                                                            ctx->tab_origin);
+  ctx->allow_brave_shields = snapshot.allow_brave_shields;
+  ctx->allow_ads = snapshot.allow_ads;
+  ctx->aggressive_blocking = snapshot.aggressive_blocking;
   ctx->allow_http_upgradable_resource =
-      !brave_shields::GetHTTPSEverywhereEnabled(map, ctx->tab_origin);
+      snapshot.allow_http_upgradable_resource;
 
   // HACK: after we fix multiple creations of BraveRequestInfo we should
   // use only tab_origin. Since we recreate BraveRequestInfo during consequent
   // stages of navigation, |tab_origin| changes and so does |allow_referrers|
   // flag, which is not what we want for determining referrers.
-  ctx->allow_referrers = brave_shields::AllowReferrers(
-      map,
-      ctx->redirect_source.is_empty() ? ctx->tab_origin : ctx->redirect_source);
-  ctx->upload_data = GetUploadData(request);
+  ctx->allow_referrers =
+      ctx->redirect_source.is_empty()
+          ? snapshot.allow_referrers
+          : brave_shields::AllowReferrers(map, ctx->redirect_source);
+  ctx->request_body = request.request_body;
 
   ctx->browser_context = browser_context;
 
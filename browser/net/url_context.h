@@ -10,6 +10,8 @@
 #include <set>
 #include <string>
 
+#include "base/memory/scoped_refptr.h"
+#include "base/strings/string_piece.h"
 #include "net/base/network_isolation_key.h"
 #include "net/http/http_request_headers.h"
 #include "net/http/http_response_headers.h"
@@ -25,8 +27,9 @@ class BrowserContext;
 }
 
 namespace network {
+class ResourceRequestBody;
 struct ResourceRequest;
-}
+}  // namespace network
 
 namespace brave {
 struct BraveRequestInfo;
@@ -116,7 +119,13 @@ struct BraveRequestInfo {
       static_cast<blink::mojom::ResourceType>(-1);
   blink::mojom::ResourceType resource_type = kInvalidResourceType;
 
-  std::string upload_data;
+  // Shared with the network::ResourceRequest, not copied.
+  scoped_refptr<network::ResourceRequestBody> request_body;
+
+  // Returns the in-memory bytes of the request body, or an empty string if
+  // there are none. A body held in a single element is returned in place;
+  // other bodies are concatenated on first use.
+  base::StringPiece GetUploadData() const;
 
   static std::shared_ptr<brave::BraveRequestInfo> MakeCTX(
       const network::ResourceRequest& request,
@@ -133,6 +142,8 @@ struct BraveRequestInfo {
 
   GURL* new_url = nullptr;
 
+  mutable absl::optional<std::string> concatenated_upload_data_;
+
   DISALLOW_COPY_AND_ASSIGN(BraveRequestInfo);
 };
 
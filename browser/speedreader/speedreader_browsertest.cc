@@ -3,8 +3,13 @@
  * License, v. 2.0. If a copy of the MPL was not distributed with this file,
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
+#include <memory>
+#include <string>
+
 #include "base/bind.h"
+#include "base/files/file_util.h"
 #include "base/path_service.h"
+#include "base/threading/thread_restrictions.h"
 #include "brave/app/brave_command_ids.h"
 #include "brave/browser/speedreader/speedreader_service_factory.h"
 #include "brave/browser/speedreader/speedreader_tab_helper.h"
@@ -26,11 +31,22 @@
 #include "content/public/test/test_navigation_observer.h"
 #include "content/public/test/test_utils.h"
 #include "net/dns/mock_host_resolver.h"
+#include "net/test/embedded_test_server/controllable_http_response.h"
 #include "net/test/embedded_test_server/embedded_test_server.h"
+#include "net/test/embedded_test_server/http_request.h"
+#include "net/test/embedded_test_server/http_response.h"
 
 const char kTestHost[] = "theguardian.com";
 const char kTestPageSimple[] = "/simple.html";
 const char kTestPageReadable[] = "/articles/guardian.html";
+const char kTestPageChunked[] = "/articles/chunked.html";
+const char kTestPageOversized[] = "/articles/oversized.html";
+
+constexpr char kHasSpeedreaderStyle[] =
+    "!!document.getElementById('brave_speedreader_style')";
+
+// Larger than the biggest body SpeedReaderURLLoader will try to distill.
+constexpr size_t kOversizedPageFillerSize = 9 * 1024 * 1024;
 
 constexpr char kSpeedreaderToggleUMAHistogramName[] =
     "Brave.SpeedReader.ToggleCount";
@@ -38,16 +54,46 @@ constexpr char kSpeedreaderToggleUMAHistogramName[] =
 constexpr char kSpeedreaderEnabledUMAHistogramName[] =
     "Brave.SpeedReader.Enabled";
 
+namespace {
+
+// Serves a page whose body is a short article followed by a comment that
+// pushes it past the streaming size limit, with a marker at the very end.
+std::unique_ptr<net::test_server::HttpResponse> HandleOversizedPage(
+    const net::test_server::HttpRequest& request) {
+  if (request.relative_url != kTestPageOversized)
+    return nullptr;
+
+  std::string body =
+      "<html><head><title>Oversized</title></head><body>"
+      "<article><h1>Oversized</h1><p>Some text.</p></article><!--";
+  body.append(kOversizedPageFillerSize, 'x');
+  body.append("--><p id=\"tail\">tail</p></body></html>");
+
+  auto response = std::make_unique<net::test_server::BasicHttpResponse>();
+  response->set_content_type("text/html");
+  response->set_content(body);
+  return response;
+}
+
+}  // namespace
+
 class SpeedReaderBrowserTest : public InProcessBrowserTest {
  public:
   SpeedReaderBrowserTest()
       : https_server_(net::EmbeddedTestServer::TYPE_HTTPS) {
-    feature_list_.InitAndEnableFeature(speedreader::kSpeedreaderFeature);
+    feature_list_.InitWithFeatures(
+        {speedreader::kSpeedreaderFeature,
+         speedreader::kSpeedreaderStreamingFeature},
+        {});
     brave::RegisterPathProvider();
-    base::FilePath test_data_dir;
-    base::PathService::Get(brave::DIR_TEST_DATA, &test_data_dir);
+    base::PathService::Get(brave::DIR_TEST_DATA, &test_data_dir_);
     https_server_.SetSSLConfig(net::EmbeddedTestServer::CERT_OK);
-    https_server_.ServeFilesFromDirectory(test_data_dir);
+    https_server_.ServeFilesFromDirectory(test_data_dir_);
+    https_server_.RegisterRequestHandler(
+        base::BindRepeating(&HandleOversizedPage));
+    chunked_response_ =
+        std::make_unique<net::test_server::ControllableHttpResponse>(
+            &https_server_, kTestPageChunked);
     EXPECT_TRUE(https_server_.Start());
   }
 
@@ -110,7 +156,10 @@ class SpeedReaderBrowserTest : public InProcessBrowserTest {
 
  protected:
   base::test::ScopedFeatureList feature_list_;
+  base::FilePath test_data_dir_;
   net::EmbeddedTestServer https_server_;
+  std::unique_ptr<net::test_server::ControllableHttpResponse>
+      chunked_response_;
 };
 
 IN_PROC_BROWSER_TEST_F(SpeedReaderBrowserTest, RestoreSpeedreaderPage) {
@@ -202,3 +251,51 @@ IN_PROC_BROWSER_TEST_F(SpeedReaderBrowserTest, P3ATest) {
   tester.ExpectBucketCount(kSpeedreaderToggleUMAHistogramName, 1, 1);
   tester.ExpectBucketCount(kSpeedreaderToggleUMAHistogramName, 2, 0);
 }
+
+IN_PROC_BROWSER_TEST_F(SpeedReaderBrowserTest, DistillsChunkedBody) {
+  std::string article;
+  {
+    base::ScopedAllowBlockingForTesting allow_blocking;
+    ASSERT_TRUE(base::ReadFileToString(
+        test_data_dir_.AppendASCII("articles").AppendASCII("guardian.html"),
+        &article));
+  }
+
+  ToggleSpeedreader();
+  ui_test_utils::NavigateToURLWithDisposition(
+      browser(), https_server_.GetURL(kTestHost, kTestPageChunked),
+      WindowOpenDisposition::NEW_FOREGROUND_TAB,
+      ui_test_utils::BROWSER_TEST_WAIT_FOR_TAB);
+  chunked_response_->WaitForRequest();
+  chunked_response_->Send(
+      "HTTP/1.1 200 OK\r\n"
+      "Content-Type: text/html; charset=utf-8\r\n"
+      "\r\n");
+
+  // Hand the body over in small pieces so the loader sees many separate
+  // reads before the body is complete.
+  constexpr size_t kChunkSize = 4096;
+  for (size_t offset = 0; offset < article.size(); offset += kChunkSize)
+    chunked_response_->Send(article.substr(offset, kChunkSize));
+  chunked_response_->Done();
+
+  EXPECT_TRUE(WaitForLoadStop(ActiveWebContents()));
+  EXPECT_TRUE(
+      speedreader::PageStateIsDistilled(tab_helper()->PageDistillState()));
+  EXPECT_EQ(true, content::EvalJs(ActiveWebContents()->GetMainFrame(),
+                                  kHasSpeedreaderStyle));
+}
+
+IN_PROC_BROWSER_TEST_F(SpeedReaderBrowserTest, PassesThroughOversizedBody) {
+  ToggleSpeedreader();
+  NavigateToPageSynchronously(kTestPageOversized);
+
+  // The whole body reaches the renderer untouched, including what arrived
+  // after distilling was abandoned.
+  content::RenderFrameHost* rfh = ActiveWebContents()->GetMainFrame();
+  EXPECT_EQ(false, content::EvalJs(rfh, kHasSpeedreaderStyle));
+  EXPECT_EQ("tail", content::EvalJs(rfh, "document.getElementById('tail')"
+                                         ".textContent"));
+  EXPECT_EQ(static_cast<int>(kOversizedPageFillerSize),
+            content::EvalJs(rfh, "document.body.childNodes[1].data.length"));
+}
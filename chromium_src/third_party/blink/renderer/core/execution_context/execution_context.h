@@ -10,7 +10,7 @@
 
 #include <random>
 
-#include "base/callback.h"
+#include "brave/third_party/blink/renderer/brave_audio_farbler.h"
 
 namespace blink {
 class WebContentSettingsClient;
@@ -23,8 +23,6 @@ using blink::Supplement;
 
 namespace brave {
 
-typedef base::RepeatingCallback<float(float, size_t)> AudioFarblingCallback;
-
 CORE_EXPORT blink::WebContentSettingsClient* GetContentSettingsClientFor(
     ExecutionContext* context);
 
@@ -39,8 +37,7 @@ class CORE_EXPORT BraveSessionCache final
 
   static BraveSessionCache& From(ExecutionContext&);
 
-  AudioFarblingCallback GetAudioFarblingCallback(
-      blink::WebContentSettingsClient* settings);
+  AudioFarbler GetAudioFarbler(blink::WebContentSettingsClient* settings);
   void PerturbPixels(blink::WebContentSettingsClient* settings,
                      const unsigned char* data,
                      size_t size);
@@ -52,6 +49,11 @@ class CORE_EXPORT BraveSessionCache final
   bool farbling_enabled_;
   uint64_t session_key_;
   uint8_t domain_key_[32];
+  // Perturbation seed of the last canvas read back, keyed by its size and
+  // content digest. A size of 0 means there is none yet.
+  size_t last_canvas_size_ = 0;
+  uint64_t last_canvas_digest_ = 0;
+  uint8_t last_canvas_key_[32];
 
   void PerturbPixelsInternal(const unsigned char* data, size_t size);
 };
@@ -3,24 +3,27 @@
  * License, v. 2.0. If a copy of the MPL was not distributed with this file,
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
-#define BRAVE_REALTIMEANALYSER_CONVERTFLOATTODB                       \
-  if (audio_farbling_callback_) {                                     \
-    destination[i] = audio_farbling_callback_.Run(destination[i], i); \
+// The float variants farble the finished output in one pass once the last
+// sample has been written; the byte variants farble an intermediate value
+// before it is clipped and quantized.
+#define BRAVE_REALTIMEANALYSER_CONVERTFLOATTODB    \
+  if (i + 1 == len) {                              \
+    audio_farbler_.FarbleBuffer(destination, len); \
   }
 
-#define BRAVE_REALTIMEANALYSER_CONVERTTOBYTEDATA                  \
-  if (audio_farbling_callback_) {                                 \
-    scaled_value = audio_farbling_callback_.Run(scaled_value, i); \
+#define BRAVE_REALTIMEANALYSER_CONVERTTOBYTEDATA                 \
+  if (audio_farbler_) {                                          \
+    scaled_value = audio_farbler_.FarbleSample(scaled_value, i); \
   }
 
-#define BRAVE_REALTIMEANALYSER_GETFLOATTIMEDOMAINDATA        \
-  if (audio_farbling_callback_) {                            \
-    destination[i] = audio_farbling_callback_.Run(value, i); \
+#define BRAVE_REALTIMEANALYSER_GETFLOATTIMEDOMAINDATA \
+  if (i + 1 == len) {                                 \
+    audio_farbler_.FarbleBuffer(destination, len);    \
   }
 
 #define BRAVE_REALTIMEANALYSER_GETBYTETIMEDOMAINDATA \
-  if (audio_farbling_callback_) {                    \
-    value = audio_farbling_callback_.Run(value, i);  \
+  if (audio_farbler_) {                              \
+    value = audio_farbler_.FarbleSample(value, i);   \
   }
 
 #include "../../../../../../../third_party/blink/renderer/modules/webaudio/realtime_analyser.cc"
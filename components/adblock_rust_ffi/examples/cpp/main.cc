@@ -316,6 +316,35 @@ void TestUrlCosmetics() {
   assert(bad_b_resources == bad_b_result);
 }
 
+void TestTypedCosmetics() {
+  adblock::Engine engine(
+      "a.com###element\n"
+      "##.ads\n"
+      "a.com#@#.ads\n"
+      "b.*##div:style(background: #fff)\n");
+
+  adblock::UrlCosmeticResources a_resources =
+      engine.getUrlCosmeticResources("https://a.com");
+  assert(a_resources.hide_selectors ==
+         std::vector<std::string>({"#element"}));
+  assert(a_resources.style_selectors.empty());
+  assert(a_resources.exceptions == std::vector<std::string>({".ads"}));
+  assert(a_resources.injected_script.empty());
+  assert(!a_resources.generichide);
+
+  adblock::UrlCosmeticResources b_resources =
+      engine.getUrlCosmeticResources("https://b.com");
+  assert(b_resources.hide_selectors.empty());
+  assert(b_resources.style_selectors.size() == 1);
+  assert(b_resources.style_selectors["div"] ==
+         std::vector<std::string>({"background: #fff"}));
+
+  std::vector<std::string> selectors = engine.getHiddenClassIdSelectors(
+      std::vector<std::string>({"ads", "no-ads"}),
+      std::vector<std::string>({"element"}), std::vector<std::string>());
+  assert(selectors == std::vector<std::string>({".ads"}));
+}
+
 void TestSubdomainUrlCosmetics() {
   adblock::Engine engine(
       "a.co.uk##.element\n"
@@ -435,6 +464,7 @@ int main() {
   TestException();
   TestClassId();
   TestUrlCosmetics();
+  TestTypedCosmetics();
   TestSubdomainUrlCosmetics();
   TestGenerichide();
   TestCosmeticScriptletResources();
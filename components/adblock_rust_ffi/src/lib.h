@@ -16,6 +16,17 @@
  */
 typedef struct C_Engine C_Engine;
 
+/**
+ * Cosmetic filtering resources specific to a url, stored as C strings so that
+ * they can be read directly from C++ without a JSON round-trip.
+ */
+typedef struct C_CosmeticResources C_CosmeticResources;
+
+/**
+ * A list of C strings owned by the adblock library.
+ */
+typedef struct C_StringList C_StringList;
+
 /**
  * An external callback that receives a hostname and two out-parameters for
  * start and end position. The callback should fill the start and end positions
@@ -134,4 +145,120 @@ char* engine_hidden_class_id_selectors(struct C_Engine* engine,
                                        const char* const* exceptions,
                                        size_t exceptions_size);
 
+/**
+ * Returns a set of cosmetic filtering resources specific to the given url. The
+ * result must be released with `cosmetic_resources_destroy`.
+ */
+struct C_CosmeticResources* engine_url_cosmetic_resources_list(
+    struct C_Engine* engine,
+    const char* url);
+
+/**
+ * Returns the number of hide selectors in `resources`.
+ */
+size_t cosmetic_resources_hide_selectors_size(
+    const struct C_CosmeticResources* resources);
+
+/**
+ * Returns the hide selector at `index`. The pointer is valid until `resources`
+ * is destroyed.
+ */
+const char* cosmetic_resources_hide_selector(
+    const struct C_CosmeticResources* resources,
+    size_t index);
+
+/**
+ * Returns the number of selectors with style rules in `resources`.
+ */
+size_t cosmetic_resources_style_selectors_size(
+    const struct C_CosmeticResources* resources);
+
+/**
+ * Returns the style selector at `index`. The pointer is valid until
+ * `resources` is destroyed.
+ */
+const char* cosmetic_resources_style_selector(
+    const struct C_CosmeticResources* resources,
+    size_t index);
+
+/**
+ * Returns the number of styles for the style selector at `index`.
+ */
+size_t cosmetic_resources_styles_size(
+    const struct C_CosmeticResources* resources,
+    size_t index);
+
+/**
+ * Returns style number `style_index` of the style selector at `index`. The
+ * pointer is valid until `resources` is destroyed.
+ */
+const char* cosmetic_resources_style(
+    const struct C_CosmeticResources* resources,
+    size_t index,
+    size_t style_index);
+
+/**
+ * Returns the number of exceptions in `resources`.
+ */
+size_t cosmetic_resources_exceptions_size(
+    const struct C_CosmeticResources* resources);
+
+/**
+ * Returns the exception at `index`. The pointer is valid until `resources` is
+ * destroyed.
+ */
+const char* cosmetic_resources_exception(
+    const struct C_CosmeticResources* resources,
+    size_t index);
+
+/**
+ * Returns the scriptlet injection script. The pointer is valid until
+ * `resources` is destroyed.
+ */
+const char* cosmetic_resources_injected_script(
+    const struct C_CosmeticResources* resources);
+
+/**
+ * Returns whether generic cosmetic rules should be skipped.
+ */
+bool cosmetic_resources_generichide(
+    const struct C_CosmeticResources* resources);
+
+/**
+ * Destroy a `CosmeticResources` once you are done with it.
+ */
+void cosmetic_resources_destroy(struct C_CosmeticResources* resources);
+
+/**
+ * Returns the generic cosmetic selectors that begin with any of the provided
+ * class and id selectors, as a list. The result must be released with
+ * `string_list_destroy`.
+ *
+ * The leading '.' or '#' character should not be provided
+ */
+struct C_StringList* engine_hidden_class_id_selectors_list(
+    struct C_Engine* engine,
+    const char* const* classes,
+    size_t classes_size,
+    const char* const* ids,
+    size_t ids_size,
+    const char* const* exceptions,
+    size_t exceptions_size);
+
+/**
+ * Returns the number of strings in `list`.
+ */
+size_t string_list_size(const struct C_StringList* list);
+
+/**
+ * Returns the string at `index`. The pointer is valid until `list` is
+ * destroyed.
+ */
+const char* string_list_at(const struct C_StringList* list, size_t index);
+
+/**
+ * Destroy a `StringList` once you are done with it.
+ */
+void string_list_destroy(struct C_StringList* list);
+
 #endif /* BRAVE_COMPONENTS_ADBLOCK_RUST_FFI_SRC_LIB_H_ */
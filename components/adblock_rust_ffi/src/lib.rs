@@ -292,3 +292,209 @@ pub unsafe extern "C" fn engine_hidden_class_id_selectors(
     let stylesheet = engine.hidden_class_id_selectors(&classes, &ids, &exceptions);
     CString::new(serde_json::to_string(&stylesheet).unwrap_or_else(|_| "".into())).expect("Error: CString::new()").into_raw()
 }
+
+/// Cosmetic filtering resources specific to a url, stored as C strings so that they can be read
+/// directly from C++ without a JSON round-trip.
+pub struct CosmeticResources {
+    hide_selectors: Vec<CString>,
+    style_selectors: Vec<(CString, Vec<CString>)>,
+    exceptions: Vec<CString>,
+    injected_script: CString,
+    generichide: bool,
+}
+
+/// A list of C strings owned by the adblock library.
+pub struct StringList {
+    items: Vec<CString>,
+}
+
+fn to_c_string(s: String) -> CString {
+    CString::new(s).unwrap_or_else(|_| CString::new("").expect("Error: CString::new()"))
+}
+
+/// Returns a set of cosmetic filtering resources specific to the given url. The result must be
+/// released with `cosmetic_resources_destroy`.
+#[no_mangle]
+pub unsafe extern "C" fn engine_url_cosmetic_resources_list(
+    engine: *mut Engine,
+    url: *const c_char,
+) -> *mut CosmeticResources {
+    let url = CStr::from_ptr(url).to_str().unwrap();
+    assert!(!engine.is_null());
+    let engine = Box::leak(Box::from_raw(engine));
+    let resources = engine.url_cosmetic_resources(url);
+    Box::into_raw(Box::new(CosmeticResources {
+        hide_selectors: resources.hide_selectors.into_iter().map(to_c_string).collect(),
+        style_selectors: resources
+            .style_selectors
+            .into_iter()
+            .map(|(selector, styles)| {
+                (to_c_string(selector), styles.into_iter().map(to_c_string).collect())
+            })
+            .collect(),
+        exceptions: resources.exceptions.into_iter().map(to_c_string).collect(),
+        injected_script: to_c_string(resources.injected_script),
+        generichide: resources.generichide,
+    }))
+}
+
+/// Returns the number of hide selectors in `resources`.
+#[no_mangle]
+pub unsafe extern "C" fn cosmetic_resources_hide_selectors_size(
+    resources: *const CosmeticResources,
+) -> size_t {
+    assert!(!resources.is_null());
+    (*resources).hide_selectors.len()
+}
+
+/// Returns the hide selector at `index`. The pointer is valid until `resources` is destroyed.
+#[no_mangle]
+pub unsafe extern "C" fn cosmetic_resources_hide_selector(
+    resources: *const CosmeticResources,
+    index: size_t,
+) -> *const c_char {
+    assert!(!resources.is_null());
+    (*resources).hide_selectors[index].as_ptr()
+}
+
+/// Returns the number of selectors with style rules in `resources`.
+#[no_mangle]
+pub unsafe extern "C" fn cosmetic_resources_style_selectors_size(
+    resources: *const CosmeticResources,
+) -> size_t {
+    assert!(!resources.is_null());
+    (*resources).style_selectors.len()
+}
+
+/// Returns the style selector at `index`. The pointer is valid until `resources` is destroyed.
+#[no_mangle]
+pub unsafe extern "C" fn cosmetic_resources_style_selector(
+    resources: *const CosmeticResources,
+    index: size_t,
+) -> *const c_char {
+    assert!(!resources.is_null());
+    (*resources).style_selectors[index].0.as_ptr()
+}
+
+/// Returns the number of styles for the style selector at `index`.
+#[no_mangle]
+pub unsafe extern "C" fn cosmetic_resources_styles_size(
+    resources: *const CosmeticResources,
+    index: size_t,
+) -> size_t {
+    assert!(!resources.is_null());
+    (*resources).style_selectors[index].1.len()
+}
+
+/// Returns style number `style_index` of the style selector at `index`. The pointer is valid until
+/// `resources` is destroyed.
+#[no_mangle]
+pub unsafe extern "C" fn cosmetic_resources_style(
+    resources: *const CosmeticResources,
+    index: size_t,
+    style_index: size_t,
+) -> *const c_char {
+    assert!(!resources.is_null());
+    (*resources).style_selectors[index].1[style_index].as_ptr()
+}
+
+/// Returns the number of exceptions in `resources`.
+#[no_mangle]
+pub unsafe extern "C" fn cosmetic_resources_exceptions_size(
+    resources: *const CosmeticResources,
+) -> size_t {
+    assert!(!resources.is_null());
+    (*resources).exceptions.len()
+}
+
+/// Returns the exception at `index`. The pointer is valid until `resources` is destroyed.
+#[no_mangle]
+pub unsafe extern "C" fn cosmetic_resources_exception(
+    resources: *const CosmeticResources,
+    index: size_t,
+) -> *const c_char {
+    assert!(!resources.is_null());
+    (*resources).exceptions[index].as_ptr()
+}
+
+/// Returns the scriptlet injection script. The pointer is valid until `resources` is destroyed.
+#[no_mangle]
+pub unsafe extern "C" fn cosmetic_resources_injected_script(
+    resources: *const CosmeticResources,
+) -> *const c_char {
+    assert!(!resources.is_null());
+    (*resources).injected_script.as_ptr()
+}
+
+/// Returns whether generic cosmetic rules should be skipped.
+#[no_mangle]
+pub unsafe extern "C" fn cosmetic_resources_generichide(
+    resources: *const CosmeticResources,
+) -> bool {
+    assert!(!resources.is_null());
+    (*resources).generichide
+}
+
+/// Destroy a `CosmeticResources` once you are done with it.
+#[no_mangle]
+pub unsafe extern "C" fn cosmetic_resources_destroy(resources: *mut CosmeticResources) {
+    if !resources.is_null() {
+        drop(Box::from_raw(resources));
+    }
+}
+
+/// Returns the generic cosmetic selectors that begin with any of the provided class and id
+/// selectors, as a list. The result must be released with `string_list_destroy`.
+///
+/// The leading '.' or '#' character should not be provided
+#[no_mangle]
+pub unsafe extern "C" fn engine_hidden_class_id_selectors_list(
+    engine: *mut Engine,
+    classes: *const *const c_char,
+    classes_size: size_t,
+    ids: *const *const c_char,
+    ids_size: size_t,
+    exceptions: *const *const c_char,
+    exceptions_size: size_t,
+) -> *mut StringList {
+    let classes = std::slice::from_raw_parts(classes, classes_size);
+    let classes: Vec<String> = (0..classes_size)
+        .map(|index| CStr::from_ptr(classes[index]).to_str().unwrap().to_owned())
+        .collect();
+    let ids = std::slice::from_raw_parts(ids, ids_size);
+    let ids: Vec<String> = (0..ids_size)
+        .map(|index| CStr::from_ptr(ids[index]).to_str().unwrap().to_owned())
+        .collect();
+    let exceptions = std::slice::from_raw_parts(exceptions, exceptions_size);
+    let exceptions: std::collections::HashSet<String> = (0..exceptions_size)
+        .map(|index| CStr::from_ptr(exceptions[index]).to_str().unwrap().to_owned())
+        .collect();
+    assert!(!engine.is_null());
+    let engine = Box::leak(Box::from_raw(engine));
+    let selectors = engine.hidden_class_id_selectors(&classes, &ids, &exceptions);
+    Box::into_raw(Box::new(StringList {
+        items: selectors.into_iter().map(to_c_string).collect(),
+    }))
+}
+
+/// Returns the number of strings in `list`.
+#[no_mangle]
+pub unsafe extern "C" fn string_list_size(list: *const StringList) -> size_t {
+    assert!(!list.is_null());
+    (*list).items.len()
+}
+
+/// Returns the string at `index`. The pointer is valid until `list` is destroyed.
+#[no_mangle]
+pub unsafe extern "C" fn string_list_at(list: *const StringList, index: size_t) -> *const c_char {
+    assert!(!list.is_null());
+    (*list).items[index].as_ptr()
+}
+
+/// Destroy a `StringList` once you are done with it.
+#[no_mangle]
+pub unsafe extern "C" fn string_list_destroy(list: *mut StringList) {
+    if !list.is_null() {
+        drop(Box::from_raw(list));
+    }
+}
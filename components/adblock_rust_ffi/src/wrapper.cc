@@ -40,6 +40,17 @@ FilterList::FilterList(const FilterList& other) = default;
 
 FilterList::~FilterList() {}
 
+UrlCosmeticResources::UrlCosmeticResources() = default;
+UrlCosmeticResources::UrlCosmeticResources(const UrlCosmeticResources& other) =
+    default;
+UrlCosmeticResources::UrlCosmeticResources(UrlCosmeticResources&& other) =
+    default;
+UrlCosmeticResources& UrlCosmeticResources::operator=(
+    const UrlCosmeticResources& other) = default;
+UrlCosmeticResources& UrlCosmeticResources::operator=(
+    UrlCosmeticResources&& other) = default;
+UrlCosmeticResources::~UrlCosmeticResources() = default;
+
 Engine::Engine() : raw(engine_create("")) {}
 
 Engine::Engine(const std::string& rules) : raw(engine_create(rules.c_str())) {}
@@ -147,6 +158,82 @@ const std::string Engine::hiddenClassIdSelectors(
   return stylesheet;
 }
 
+UrlCosmeticResources Engine::getUrlCosmeticResources(const std::string& url) {
+  C_CosmeticResources* resources_raw =
+      engine_url_cosmetic_resources_list(raw, url.c_str());
+
+  UrlCosmeticResources resources;
+  const size_t hide_selectors_size =
+      cosmetic_resources_hide_selectors_size(resources_raw);
+  resources.hide_selectors.reserve(hide_selectors_size);
+  for (size_t i = 0; i < hide_selectors_size; i++) {
+    resources.hide_selectors.push_back(
+        cosmetic_resources_hide_selector(resources_raw, i));
+  }
+
+  const size_t style_selectors_size =
+      cosmetic_resources_style_selectors_size(resources_raw);
+  for (size_t i = 0; i < style_selectors_size; i++) {
+    std::vector<std::string>& styles = resources.style_selectors
+        [cosmetic_resources_style_selector(resources_raw, i)];
+    const size_t styles_size = cosmetic_resources_styles_size(resources_raw, i);
+    for (size_t j = 0; j < styles_size; j++) {
+      styles.push_back(cosmetic_resources_style(resources_raw, i, j));
+    }
+  }
+
+  const size_t exceptions_size =
+      cosmetic_resources_exceptions_size(resources_raw);
+  resources.exceptions.reserve(exceptions_size);
+  for (size_t i = 0; i < exceptions_size; i++) {
+    resources.exceptions.push_back(
+        cosmetic_resources_exception(resources_raw, i));
+  }
+
+  resources.injected_script = cosmetic_resources_injected_script(resources_raw);
+  resources.generichide = cosmetic_resources_generichide(resources_raw);
+
+  cosmetic_resources_destroy(resources_raw);
+  return resources;
+}
+
+std::vector<std::string> Engine::getHiddenClassIdSelectors(
+    const std::vector<std::string>& classes,
+    const std::vector<std::string>& ids,
+    const std::vector<std::string>& exceptions) {
+  std::vector<const char*> classes_raw;
+  classes_raw.reserve(classes.size());
+  for (size_t i = 0; i < classes.size(); i++) {
+    classes_raw.push_back(classes[i].c_str());
+  }
+
+  std::vector<const char*> ids_raw;
+  ids_raw.reserve(ids.size());
+  for (size_t i = 0; i < ids.size(); i++) {
+    ids_raw.push_back(ids[i].c_str());
+  }
+
+  std::vector<const char*> exceptions_raw;
+  exceptions_raw.reserve(exceptions.size());
+  for (size_t i = 0; i < exceptions.size(); i++) {
+    exceptions_raw.push_back(exceptions[i].c_str());
+  }
+
+  C_StringList* selectors_raw = engine_hidden_class_id_selectors_list(
+      raw, classes_raw.data(), classes.size(), ids_raw.data(), ids.size(),
+      exceptions_raw.data(), exceptions.size());
+
+  std::vector<std::string> selectors;
+  const size_t selectors_size = string_list_size(selectors_raw);
+  selectors.reserve(selectors_size);
+  for (size_t i = 0; i < selectors_size; i++) {
+    selectors.push_back(string_list_at(selectors_raw, i));
+  }
+
+  string_list_destroy(selectors_raw);
+  return selectors;
+}
+
 Engine::~Engine() {
   engine_destroy(raw);
 }
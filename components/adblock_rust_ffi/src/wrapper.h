@@ -5,6 +5,7 @@
 
 #ifndef BRAVE_COMPONENTS_ADBLOCK_RUST_FFI_SRC_WRAPPER_H_
 #define BRAVE_COMPONENTS_ADBLOCK_RUST_FFI_SRC_WRAPPER_H_
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
@@ -64,6 +65,26 @@ class ADBLOCK_EXPORT FilterList {
   static std::vector<FilterList> regional_list;
 };
 
+// Cosmetic filtering resources for a single url, read directly out of the
+// engine without going through JSON.
+struct ADBLOCK_EXPORT UrlCosmeticResources {
+  UrlCosmeticResources();
+  UrlCosmeticResources(const UrlCosmeticResources& other);
+  UrlCosmeticResources(UrlCosmeticResources&& other);
+  UrlCosmeticResources& operator=(const UrlCosmeticResources& other);
+  UrlCosmeticResources& operator=(UrlCosmeticResources&& other);
+  ~UrlCosmeticResources();
+
+  std::vector<std::string> hide_selectors;
+  // Never filled in by an engine; used by callers that merge the results of
+  // several engines and need selectors that bypass first-party exceptions.
+  std::vector<std::string> force_hide_selectors;
+  std::map<std::string, std::vector<std::string>> style_selectors;
+  std::vector<std::string> exceptions;
+  std::string injected_script;
+  bool generichide = false;
+};
+
 class ADBLOCK_EXPORT Engine {
  public:
   Engine();
@@ -96,6 +117,11 @@ class ADBLOCK_EXPORT Engine {
       const std::vector<std::string>& classes,
       const std::vector<std::string>& ids,
       const std::vector<std::string>& exceptions);
+  UrlCosmeticResources getUrlCosmeticResources(const std::string& url);
+  std::vector<std::string> getHiddenClassIdSelectors(
+      const std::vector<std::string>& classes,
+      const std::vector<std::string>& ids,
+      const std::vector<std::string>& exceptions);
   ~Engine();
 
  private:
@@ -76,6 +76,7 @@ class AdsService : public KeyedService {
   virtual bool IsEnabled() const = 0;
   virtual void SetEnabled(const bool is_enabled) = 0;
 
+  virtual bool ShouldAllowConversionTracking() const = 0;
   virtual void SetAllowConversionTracking(const bool should_allow) = 0;
 
   virtual int64_t GetAdsPerHour() const = 0;
@@ -102,6 +103,10 @@ class AdsService : public KeyedService {
 
   virtual void ChangeLocale(const std::string& locale) = 0;
 
+  // Writes out ads state changes which are still waiting to be saved, then
+  // runs |callback|. Called when the browser goes to the background
+  virtual void FlushState(base::OnceClosure callback) = 0;
+
   virtual void OnHtmlLoaded(const SessionID& tab_id,
                             const std::vector<GURL>& redirect_chain,
                             const std::string& html) = 0;
@@ -11,11 +11,13 @@
 
 #include "base/base64.h"
 #include "base/bind.h"
+#include "base/callback_helpers.h"
 #include "base/command_line.h"
 #include "base/containers/flat_map.h"
 #include "base/cxx17_backports.h"
 #include "base/debug/dump_without_crashing.h"
 #include "base/feature_list.h"
+#include "base/files/file.h"
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
 #include "base/files/important_file_writer.h"
@@ -164,6 +166,10 @@ std::string LoadOnFileTaskRunner(const base::FilePath& path) {
   return data;
 }
 
+base::File OpenFileOnFileTaskRunner(const base::FilePath& path) {
+  return base::File(path, base::File::FLAG_OPEN | base::File::FLAG_READ);
+}
+
 bool EnsureBaseDirectoryExistsOnFileTaskRunner(const base::FilePath& path) {
   if (base::DirectoryExists(path)) {
     return true;
@@ -299,12 +305,26 @@ void AdsServiceImpl::ChangeLocale(const std::string& locale) {
   bat_ads_->ChangeLocale(locale);
 }
 
+void AdsServiceImpl::FlushState(base::OnceClosure callback) {
+  if (!connected()) {
+    std::move(callback).Run();
+    return;
+  }
+
+  bat_ads_->FlushState(base::BindOnce(
+      [](base::OnceClosure callback, const bool success) {
+        VLOG_IF(0, !success) << "Failed to flush ads state";
+        std::move(callback).Run();
+      },
+      std::move(callback)));
+}
+
 void AdsServiceImpl::OnPrefChanged(const std::string& path) {
   if (!connected()) {
     return;
   }
 
-  bat_ads_->OnPrefChanged(path);
+  bat_ads_->OnPrefChanged(path, profile_->GetPrefs()->Get(path)->Clone());
 }
 
 void AdsServiceImpl::OnHtmlLoaded(const SessionID& tab_id,
@@ -527,6 +547,10 @@ bool AdsServiceImpl::IsEnabled() const {
   return GetBooleanPref(ads::prefs::kEnabled);
 }
 
+bool AdsServiceImpl::ShouldAllowConversionTracking() const {
+  return GetBooleanPref(ads::prefs::kShouldAllowConversionTracking);
+}
+
 bool AdsServiceImpl::IsBraveNewsEnabled() const {
   return GetBooleanPref(kBraveTodayOptedIn) &&
          GetBooleanPref(kNewTabPageShowToday);
@@ -1450,6 +1474,22 @@ void AdsServiceImpl::OnLoaded(const ads::LoadCallback& callback,
     callback(/* success */ true, value);
 }
 
+// static
+void AdsServiceImpl::OnFileResourceLoaded(
+    base::WeakPtr<AdsServiceImpl> ads_service,
+    scoped_refptr<base::SequencedTaskRunner> file_task_runner,
+    const ads::LoadFileCallback& callback,
+    base::File file) {
+  if (!ads_service || !ads_service->connected()) {
+    // Closing a file may block, so it must not happen on the UI thread
+    file_task_runner->PostTask(
+        FROM_HERE, base::BindOnce([](base::File file) {}, std::move(file)));
+    return;
+  }
+
+  callback(std::move(file));
+}
+
 void AdsServiceImpl::OnSaved(const ads::ResultCallback& callback,
                              const bool success) {
   if (!connected()) {
@@ -1843,6 +1883,10 @@ void AdsServiceImpl::OnPrefsChanged(const std::string& pref) {
     MaybeStart(/* should_restart */ false);
   } else if (pref == ads::prefs::kIdleTimeThreshold) {
     StartCheckIdleStateTimer();
+
+    // Keep the pref mirror in the ads utility process coherent if the pref was
+    // changed without going through |SetIntegerPref|
+    OnPrefChanged(pref);
   } else if (pref == brave_rewards::prefs::kWalletBrave) {
     OnWalletUpdated();
   }
@@ -2077,24 +2121,26 @@ void AdsServiceImpl::Save(const std::string& name,
                      std::move(callback)));
 }
 
-void AdsServiceImpl::LoadAdsResource(const std::string& id,
-                                     const int version,
-                                     ads::LoadCallback callback) {
+void AdsServiceImpl::LoadFileResource(const std::string& id,
+                                      const int version,
+                                      ads::LoadFileCallback callback) {
   const absl::optional<base::FilePath> path =
       g_brave_browser_process->resource_component()->GetPath(id, version);
 
   if (!path) {
-    callback(/* success */ false, "");
+    callback(base::File());
     return;
   }
 
   VLOG(1) << "Loading ads resource from " << path.value();
 
+  // The resource is handed to the ads service as a read-only file handle so
+  // that it can be memory mapped rather than copied across IPC
   base::PostTaskAndReplyWithResult(
       file_task_runner_.get(), FROM_HERE,
-      base::BindOnce(&LoadOnFileTaskRunner, path.value()),
-      base::BindOnce(&AdsServiceImpl::OnLoaded, AsWeakPtr(),
-                     std::move(callback)));
+      base::BindOnce(&OpenFileOnFileTaskRunner, path.value()),
+      base::BindOnce(&AdsServiceImpl::OnFileResourceLoaded, AsWeakPtr(),
+                     file_task_runner_, std::move(callback)));
 }
 
 void AdsServiceImpl::GetBrowsingHistory(
@@ -2342,6 +2388,10 @@ void AdsServiceImpl::OnBackground() {
   }
 
   bat_ads_->OnBackground();
+
+  // Pending ads state is not written out on exit, and the browser may be
+  // closed, or killed on mobile, while in the background
+  FlushState(base::DoNothing());
 }
 
 void AdsServiceImpl::OnForeground() {
@@ -15,6 +15,7 @@
 #include <string>
 #include <vector>
 
+#include "base/files/file.h"
 #include "base/files/file_path.h"
 #include "base/memory/weak_ptr.h"
 #include "base/timer/timer.h"
@@ -99,6 +100,7 @@ class AdsServiceImpl : public AdsService,
   bool IsEnabled() const override;
   void SetEnabled(const bool is_enabled) override;
 
+  bool ShouldAllowConversionTracking() const override;
   void SetAllowConversionTracking(const bool should_allow) override;
 
   int64_t GetAdsPerHour() const override;
@@ -125,6 +127,8 @@ class AdsServiceImpl : public AdsService,
 
   void ChangeLocale(const std::string& locale) override;
 
+  void FlushState(base::OnceClosure callback) override;
+
   void OnPrefChanged(const std::string& path);
 
   void OnHtmlLoaded(const SessionID& tab_id,
@@ -314,6 +318,13 @@ class AdsServiceImpl : public AdsService,
                       const bool flagged);
 
   void OnLoaded(const ads::LoadCallback& callback, const std::string& value);
+  // Static so that |file| is still closed on |file_task_runner| if the ads
+  // service has been destroyed by the time it has been opened
+  static void OnFileResourceLoaded(
+      base::WeakPtr<AdsServiceImpl> ads_service,
+      scoped_refptr<base::SequencedTaskRunner> file_task_runner,
+      const ads::LoadFileCallback& callback,
+      base::File file);
   void OnSaved(const ads::ResultCallback& callback, const bool success);
 
   void OnRunDBTransaction(ads::RunDBTransactionCallback callback,
@@ -393,9 +404,9 @@ class AdsServiceImpl : public AdsService,
 
   void Load(const std::string& name, ads::LoadCallback callback) override;
 
-  void LoadAdsResource(const std::string& id,
-                       const int version,
-                       ads::LoadCallback callback) override;
+  void LoadFileResource(const std::string& id,
+                        const int version,
+                        ads::LoadFileCallback callback) override;
 
   void GetBrowsingHistory(const int max_count,
                           const int days_ago,
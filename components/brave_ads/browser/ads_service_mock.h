@@ -0,0 +1,145 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_ADS_BROWSER_ADS_SERVICE_MOCK_H_
+#define BRAVE_COMPONENTS_BRAVE_ADS_BROWSER_ADS_SERVICE_MOCK_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "brave/components/brave_ads/browser/ads_service.h"
+
+#include "testing/gmock/include/gmock/gmock.h"
+
+namespace brave_ads {
+
+class AdsServiceMock : public AdsService {
+ public:
+  AdsServiceMock();
+  ~AdsServiceMock() override;
+
+  AdsServiceMock(const AdsServiceMock&) = delete;
+  AdsServiceMock& operator=(const AdsServiceMock&) = delete;
+
+  MOCK_CONST_METHOD0(IsSupportedLocale, bool());
+
+  MOCK_CONST_METHOD0(IsEnabled, bool());
+  MOCK_METHOD1(SetEnabled, void(const bool));
+
+  MOCK_CONST_METHOD0(ShouldAllowConversionTracking, bool());
+  MOCK_METHOD1(SetAllowConversionTracking, void(const bool));
+
+  MOCK_CONST_METHOD0(GetAdsPerHour, int64_t());
+  MOCK_METHOD1(SetAdsPerHour, void(const int64_t));
+
+  MOCK_CONST_METHOD0(ShouldAllowAdsSubdivisionTargeting, bool());
+  MOCK_CONST_METHOD0(GetAdsSubdivisionTargetingCode, std::string());
+  MOCK_METHOD1(SetAdsSubdivisionTargetingCode, void(const std::string&));
+  MOCK_CONST_METHOD0(GetAutoDetectedAdsSubdivisionTargetingCode,
+                     std::string());
+  MOCK_METHOD1(SetAutoDetectedAdsSubdivisionTargetingCode,
+               void(const std::string&));
+
+#if BUILDFLAG(BRAVE_ADAPTIVE_CAPTCHA_ENABLED)
+  MOCK_METHOD2(ShowScheduledCaptcha,
+               void(const std::string&, const std::string&));
+  MOCK_METHOD0(SnoozeScheduledCaptcha, void());
+#endif
+
+  MOCK_METHOD1(OnShowAdNotification, void(const std::string&));
+  MOCK_METHOD2(OnCloseAdNotification, void(const std::string&, const bool));
+  MOCK_METHOD1(OnClickAdNotification, void(const std::string&));
+
+  MOCK_METHOD1(ChangeLocale, void(const std::string&));
+
+  MOCK_METHOD1(FlushState, void(base::OnceClosure));
+
+  MOCK_METHOD3(OnHtmlLoaded,
+               void(const SessionID&,
+                    const std::vector<GURL>&,
+                    const std::string&));
+
+  MOCK_METHOD3(OnTextLoaded,
+               void(const SessionID&,
+                    const std::vector<GURL>&,
+                    const std::string&));
+
+  MOCK_METHOD1(OnUserGesture, void(const int32_t));
+
+  MOCK_METHOD1(OnMediaStart, void(const SessionID&));
+  MOCK_METHOD1(OnMediaStop, void(const SessionID&));
+
+  MOCK_METHOD4(OnTabUpdated,
+               void(const SessionID&, const GURL&, const bool, const bool));
+
+  MOCK_METHOD1(OnTabClosed, void(const SessionID&));
+
+  MOCK_METHOD1(OnResourceComponentUpdated, void(const std::string&));
+
+  MOCK_METHOD3(OnNewTabPageAdEvent,
+               void(const std::string&,
+                    const std::string&,
+                    const ads::mojom::NewTabPageAdEventType));
+
+  MOCK_METHOD3(OnPromotedContentAdEvent,
+               void(const std::string&,
+                    const std::string&,
+                    const ads::mojom::PromotedContentAdEventType));
+
+  MOCK_METHOD2(GetInlineContentAd,
+               void(const std::string&, OnGetInlineContentAdCallback));
+
+  MOCK_METHOD3(OnInlineContentAdEvent,
+               void(const std::string&,
+                    const std::string&,
+                    const ads::mojom::InlineContentAdEventType));
+
+  MOCK_METHOD1(PurgeOrphanedAdEventsForType, void(const ads::mojom::AdType));
+
+  MOCK_METHOD0(ReconcileAdRewards, void());
+
+  MOCK_METHOD3(GetAdsHistory,
+               void(const double, const double, OnGetAdsHistoryCallback));
+
+  MOCK_METHOD1(GetAccountStatement, void(GetAccountStatementCallback));
+
+  MOCK_METHOD1(GetAdDiagnostics, void(GetAdDiagnosticsCallback));
+
+  MOCK_METHOD4(ToggleAdThumbUp,
+               void(const std::string&,
+                    const std::string&,
+                    const int,
+                    OnToggleAdThumbUpCallback));
+  MOCK_METHOD4(ToggleAdThumbDown,
+               void(const std::string&,
+                    const std::string&,
+                    const int,
+                    OnToggleAdThumbDownCallback));
+  MOCK_METHOD3(ToggleAdOptInAction,
+               void(const std::string&,
+                    const int,
+                    OnToggleAdOptInActionCallback));
+  MOCK_METHOD3(ToggleAdOptOutAction,
+               void(const std::string&,
+                    const int,
+                    OnToggleAdOptOutActionCallback));
+  MOCK_METHOD4(ToggleSaveAd,
+               void(const std::string&,
+                    const std::string&,
+                    const bool,
+                    OnToggleSaveAdCallback));
+  MOCK_METHOD4(ToggleFlagAd,
+               void(const std::string&,
+                    const std::string&,
+                    const bool,
+                    OnToggleFlagAdCallback));
+
+  MOCK_METHOD1(ResetAllState, void(const bool));
+};
+
+}  // namespace brave_ads
+
+#endif  // BRAVE_COMPONENTS_BRAVE_ADS_BROWSER_ADS_SERVICE_MOCK_H_
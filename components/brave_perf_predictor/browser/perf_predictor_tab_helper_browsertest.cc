@@ -7,6 +7,7 @@
 #include "base/task/post_task.h"
 #include "base/test/thread_test_helper.h"
 #include "brave/browser/brave_browser_process.h"
+#include "brave/browser/brave_shields/brave_shields_web_contents_observer.h"
 #include "brave/common/brave_paths.h"
 #include "brave/common/pref_names.h"
 #include "brave/components/brave_component_updater/browser/local_data_files_service.h"
@@ -46,6 +47,14 @@ class PerfPredictorTabHelperTest : public InProcessBrowserTest {
   void SetUpOnMainThread() override {
     InProcessBrowserTest::SetUpOnMainThread();
     host_resolver()->AddRule("*", "127.0.0.1");
+    brave_shields::BraveShieldsWebContentsObserver::
+        SetShouldFlushBlockedCountsImmediatelyForTesting(true);
+  }
+
+  void TearDownOnMainThread() override {
+    brave_shields::BraveShieldsWebContentsObserver::
+        SetShouldFlushBlockedCountsImmediatelyForTesting(false);
+    InProcessBrowserTest::TearDownOnMainThread();
   }
 
   void SetUp() override {
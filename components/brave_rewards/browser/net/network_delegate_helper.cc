@@ -8,11 +8,13 @@
 #include <memory>
 #include <string>
 
+#include "base/strings/string_piece.h"
 #include "base/task/post_task.h"
 #include "brave/components/brave_rewards/browser/rewards_service.h"
 #include "brave/browser/brave_rewards/rewards_service_factory.h"
 #include "chrome/browser/profiles/profile.h"
 #include "components/sessions/content/session_tab_helper.h"
+#include "content/public/browser/browser_context.h"
 #include "content/public/browser/browser_task_traits.h"
 #include "content/public/browser/browser_thread.h"
 #include "content/public/browser/render_frame_host.h"
@@ -24,7 +26,7 @@ namespace brave_rewards {
 namespace {
 
 void DispatchOnUI(
-    const std::string post_data,
+    base::StringPiece post_data,
     const GURL url,
     const GURL first_party_url,
     const std::string referrer,
@@ -47,6 +49,15 @@ void DispatchOnUI(
                                 GURL(referrer), post_data);
 }
 
+bool IsRewardsEnabledForContext(content::BrowserContext* browser_context) {
+  if (!browser_context)
+    return false;
+
+  auto* rewards_service = RewardsServiceFactory::GetForProfile(
+      Profile::FromBrowserContext(browser_context));
+  return rewards_service && rewards_service->IsRewardsEnabled();
+}
+
 }  // namespace
 
 int OnBeforeURLRequest(
@@ -54,11 +65,16 @@ int OnBeforeURLRequest(
   std::shared_ptr<brave::BraveRequestInfo> ctx) {
   DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
 
-  if (IsMediaLink(ctx->request_url, ctx->tab_origin, ctx->referrer)) {
-    if (!ctx->upload_data.empty()) {
-      DispatchOnUI(ctx->upload_data, ctx->request_url, ctx->tab_url,
-                   ctx->referrer.spec(), ctx->frame_tree_node_id);
-    }
+  if (!IsMediaLink(ctx->request_url, ctx->tab_origin, ctx->referrer))
+    return net::OK;
+
+  if (!IsRewardsEnabledForContext(ctx->browser_context))
+    return net::OK;
+
+  base::StringPiece upload_data = ctx->GetUploadData();
+  if (!upload_data.empty()) {
+    DispatchOnUI(upload_data, ctx->request_url, ctx->tab_url,
+                 ctx->referrer.spec(), ctx->frame_tree_node_id);
   }
 
   return net::OK;
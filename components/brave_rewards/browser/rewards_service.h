@@ -14,6 +14,7 @@
 #include "base/containers/flat_map.h"
 #include "base/macros.h"
 #include "base/observer_list.h"
+#include "base/strings/string_piece.h"
 #include "brave/components/brave_rewards/browser/rewards_notification_service.h"
 #include "brave/vendor/bat-native-ledger/include/bat/ledger/mojom_structs.h"
 #include "build/build_config.h"
@@ -177,7 +178,7 @@ class RewardsService : public KeyedService {
                           const GURL& url,
                           const GURL& first_party_url,
                           const GURL& referrer,
-                          const std::string& post_data) = 0;
+                          base::StringPiece post_data) = 0;
 
   virtual void GetReconcileStamp(GetReconcileStampCallback callback) = 0;
   virtual void GetPublisherMinVisitTime(
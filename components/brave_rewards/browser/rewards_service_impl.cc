@@ -279,11 +279,25 @@ std::string GetPrefPath(const std::string& name) {
   return base::StringPrintf("%s.%s", pref_prefix, name.c_str());
 }
 
+// Hosts whose requests can carry the media pings the ledger matches on
+// (Twitch segments and Vimeo player stats). Nearly every request fails this
+// check, so it is done on the parsed host before any spec strings are copied.
+bool IsMediaLinkHost(const GURL& url) {
+  if (!url.SchemeIsHTTPOrHTTPS())
+    return false;
+
+  return url.DomainIs("ttvnw.net") ||
+         url.host_piece() == "fresnel.vimeocdn.com";
+}
+
 }  // namespace
 
 bool IsMediaLink(const GURL& url,
                  const GURL& first_party_url,
                  const GURL& referrer) {
+  if (!IsMediaLinkHost(url))
+    return false;
+
   return ledger::Ledger::IsMediaLink(url.spec(),
                                      first_party_url.spec(),
                                      referrer.spec());
@@ -419,9 +433,25 @@ void RewardsServiceImpl::InitPrefChangeRegistrar() {
       ads::prefs::kEnabled,
       base::BindRepeating(&RewardsServiceImpl::OnPreferenceChanged,
                           base::Unretained(this)));
+  profile_pref_change_registrar_.Add(
+      prefs::kExternalWalletType,
+      base::BindRepeating(&RewardsServiceImpl::OnPreferenceChanged,
+                          base::Unretained(this)));
+  profile_pref_change_registrar_.Add(
+      prefs::kMinVisitTime,
+      base::BindRepeating(&RewardsServiceImpl::OnPreferenceChanged,
+                          base::Unretained(this)));
 }
 
 void RewardsServiceImpl::OnPreferenceChanged(const std::string& key) {
+  // The ledger process mirrors its state, so send it the new value of any
+  // state that changed, including its own writes
+  const std::string state_prefix = GetPrefPath("");
+  if (Connected() && base::StartsWith(key, state_prefix)) {
+    bat_ledger_->OnStateChanged(key.substr(state_prefix.length()),
+                                profile_->GetPrefs()->Get(key)->Clone());
+  }
+
   if (key == prefs::kAutoContributeEnabled) {
     if (profile_->GetPrefs()->GetBoolean(prefs::kAutoContributeEnabled)) {
       StartLedgerProcessIfNecessary();
@@ -730,7 +760,7 @@ void RewardsServiceImpl::OnPostData(SessionID tab_id,
                                     const GURL& url,
                                     const GURL& first_party_url,
                                     const GURL& referrer,
-                                    const std::string& post_data) {
+                                    base::StringPiece post_data) {
   if (!Connected()) {
     return;
   }
@@ -741,7 +771,7 @@ void RewardsServiceImpl::OnPostData(SessionID tab_id,
 
   std::string output;
   url::RawCanonOutputW<1024> canonOutput;
-  url::DecodeURLEscapeSequences(post_data.c_str(),
+  url::DecodeURLEscapeSequences(post_data.data(),
                                 post_data.length(),
                                 url::DecodeURLMode::kUTF8OrIsomorphic,
                                 &canonOutput);
@@ -21,6 +21,7 @@
 #include "base/observer_list.h"
 #include "base/one_shot_event.h"
 #include "base/sequence_checker.h"
+#include "base/strings/string_piece.h"
 #include "base/values.h"
 #include "bat/ledger/ledger.h"
 #include "bat/ledger/ledger_client.h"
@@ -155,7 +156,7 @@ class RewardsServiceImpl : public RewardsService,
                   const GURL& url,
                   const GURL& first_party_url,
                   const GURL& referrer,
-                  const std::string& post_data) override;
+                  base::StringPiece post_data) override;
   std::string URIEncode(const std::string& value) override;
   void GetReconcileStamp(GetReconcileStampCallback callback) override;
   void GetAutoContributeEnabled(
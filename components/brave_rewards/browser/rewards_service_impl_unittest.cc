@@ -156,4 +156,28 @@ TEST_F(RewardsServiceTest, GetExternalWalletMultipleCustodians) {
 }
 #endif
 
+TEST_F(RewardsServiceTest, IsMediaLink) {
+  const GURL twitch_tab("https://www.twitch.tv/some_channel");
+  const GURL twitch_player("https://player.twitch.tv/");
+
+  EXPECT_TRUE(IsMediaLink(
+      GURL("https://video-weaver.sea02.hls.ttvnw.net/v1/segment/abc.ts"),
+      twitch_tab, GURL()));
+  EXPECT_TRUE(IsMediaLink(
+      GURL("https://video-weaver.sea02.hls.ttvnw.net/v1/segment/abc.ts"),
+      GURL(), twitch_player));
+  EXPECT_TRUE(IsMediaLink(
+      GURL("https://fresnel.vimeocdn.com/add/player-stats?beacon=1"),
+      GURL(), GURL()));
+
+  EXPECT_FALSE(IsMediaLink(
+      GURL("https://video-weaver.sea02.hls.ttvnw.net/v1/segment/abc.ts"),
+      GURL("https://brave.com/"), GURL()));
+  EXPECT_FALSE(IsMediaLink(
+      GURL("https://brave.com/?https://fresnel.vimeocdn.com/add/player-stats?"),
+      GURL(), GURL()));
+  EXPECT_FALSE(IsMediaLink(
+      GURL("https://brave.com/v1/segment/abc.ts"), twitch_tab, GURL()));
+}
+
 }  // namespace brave_rewards
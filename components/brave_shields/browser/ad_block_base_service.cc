@@ -6,6 +6,7 @@
 #include "brave/components/brave_shields/browser/ad_block_base_service.h"
 
 #include <algorithm>
+#include <atomic>
 #include <set>
 #include <string>
 #include <utility>
@@ -13,7 +14,6 @@
 
 #include "base/bind.h"
 #include "base/files/file_path.h"
-#include "base/json/json_reader.h"
 #include "base/macros.h"
 #include "base/memory/ptr_util.h"
 #include "base/strings/utf_string_conversions.h"
@@ -104,12 +104,21 @@ std::string ResourceTypeToString(blink::mojom::ResourceType resource_type) {
 
 namespace brave_shields {
 
+namespace {
+
+std::atomic<uint64_t> g_engine_generation{0};
+
+}  // namespace
+
 AdBlockBaseService::AdBlockBaseService(BraveComponent::Delegate* delegate)
     : BaseBraveShieldsService(delegate),
       ad_block_client_(new adblock::Engine()),
-      weak_factory_(this) {}
+      weak_factory_(this) {
+  IncrementEngineGeneration();
+}
 
 AdBlockBaseService::~AdBlockBaseService() {
+  IncrementEngineGeneration();
   GetTaskRunner()->DeleteSoon(FROM_HERE, ad_block_client_.release());
 }
 
@@ -176,6 +185,7 @@ void AdBlockBaseService::EnableTag(const std::string& tag, bool enabled) {
     return;
   }
 
+  IncrementEngineGeneration();
   if (enabled) {
     if (tags_.find(tag) == tags_.end()) {
       ad_block_client_->addTag(tag);
@@ -201,22 +211,23 @@ void AdBlockBaseService::AddResources(const std::string& resources) {
 
   ad_block_client_->addResources(resources);
   resources_ = resources;
+  IncrementEngineGeneration();
 }
 
 bool AdBlockBaseService::TagExists(const std::string& tag) {
   return std::find(tags_.begin(), tags_.end(), tag) != tags_.end();
 }
 
-absl::optional<base::Value> AdBlockBaseService::UrlCosmeticResources(
+adblock::UrlCosmeticResources AdBlockBaseService::UrlCosmeticResources(
     const std::string& url) {
   // if (!IsInitialized())
   //   return;
 
   DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
-  return base::JSONReader::Read(ad_block_client_->urlCosmeticResources(url));
+  return ad_block_client_->getUrlCosmeticResources(url);
 }
 
-absl::optional<base::Value> AdBlockBaseService::HiddenClassIdSelectors(
+std::vector<std::string> AdBlockBaseService::HiddenClassIdSelectors(
     const std::vector<std::string>& classes,
     const std::vector<std::string>& ids,
     const std::vector<std::string>& exceptions) {
@@ -224,8 +235,7 @@ absl::optional<base::Value> AdBlockBaseService::HiddenClassIdSelectors(
   //   return;
 
   DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
-  return base::JSONReader::Read(
-      ad_block_client_->hiddenClassIdSelectors(classes, ids, exceptions));
+  return ad_block_client_->getHiddenClassIdSelectors(classes, ids, exceptions);
 }
 
 void AdBlockBaseService::GetDATFileData(const base::FilePath& dat_file_path,
@@ -266,6 +276,7 @@ void AdBlockBaseService::UpdateAdBlockClient(
   ad_block_client_ = std::move(ad_block_client);
   AddKnownTagsToAdBlockInstance();
   AddKnownResourcesToAdBlockInstance();
+  IncrementEngineGeneration();
 }
 
 void AdBlockBaseService::AddKnownTagsToAdBlockInstance() {
@@ -293,6 +304,17 @@ void AdBlockBaseService::ResetForTest(const std::string& rules,
     resources_ = resources;
   }
   AddKnownResourcesToAdBlockInstance();
+  IncrementEngineGeneration();
+}
+
+// static
+uint64_t AdBlockBaseService::GetEngineGeneration() {
+  return g_engine_generation.load(std::memory_order_acquire);
+}
+
+// static
+void AdBlockBaseService::IncrementEngineGeneration() {
+  g_engine_generation.fetch_add(1, std::memory_order_acq_rel);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
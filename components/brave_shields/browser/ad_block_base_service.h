@@ -18,6 +18,7 @@
 #include "base/memory/weak_ptr.h"
 #include "base/sequence_checker.h"
 #include "base/values.h"
+#include "brave/components/adblock_rust_ffi/src/wrapper.h"
 #include "brave/components/brave_component_updater/browser/dat_file_util.h"
 #include "brave/components/brave_shields/browser/base_brave_shields_service.h"
 #include "third_party/blink/public/mojom/loader/resource_load_info.mojom-shared.h"
@@ -27,9 +28,6 @@ class BraveAdBlockTPNetworkDelegateHelperTest;
 class PerfPredictorTabHelperTest;
 
 using brave_component_updater::BraveComponent;
-namespace adblock {
-class Engine;
-}
 
 namespace brave_shields {
 
@@ -59,13 +57,19 @@ class AdBlockBaseService : public BaseBraveShieldsService {
   void EnableTag(const std::string& tag, bool enabled);
   bool TagExists(const std::string& tag);
 
-  virtual absl::optional<base::Value> UrlCosmeticResources(
+  virtual adblock::UrlCosmeticResources UrlCosmeticResources(
       const std::string& url);
-  virtual absl::optional<base::Value> HiddenClassIdSelectors(
+  virtual std::vector<std::string> HiddenClassIdSelectors(
       const std::vector<std::string>& classes,
       const std::vector<std::string>& ids,
       const std::vector<std::string>& exceptions);
 
+  // Returns a counter that changes whenever any adblock engine is created,
+  // destroyed or modified, or when the set of engines consulted for a request
+  // changes. Results derived from the engines can be cached against it.
+  static uint64_t GetEngineGeneration();
+  static void IncrementEngineGeneration();
+
  protected:
   friend class ::AdBlockServiceTest;
   friend class ::BraveAdBlockTPNetworkDelegateHelperTest;
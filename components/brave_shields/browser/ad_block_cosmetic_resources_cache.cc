@@ -0,0 +1,41 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/ad_block_cosmetic_resources_cache.h"
+
+namespace brave_shields {
+
+AdBlockCosmeticResourcesCache::AdBlockCosmeticResourcesCache(size_t size)
+    : entries_(size) {
+  DETACH_FROM_SEQUENCE(sequence_checker_);
+}
+
+AdBlockCosmeticResourcesCache::~AdBlockCosmeticResourcesCache() = default;
+
+bool AdBlockCosmeticResourcesCache::Get(
+    const std::string& host,
+    uint64_t generation,
+    adblock::UrlCosmeticResources* resources) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  auto it = entries_.Get(host);
+  if (it == entries_.end())
+    return false;
+  if (it->second.generation != generation) {
+    entries_.Erase(it);
+    return false;
+  }
+  *resources = it->second.resources;
+  return true;
+}
+
+void AdBlockCosmeticResourcesCache::Put(
+    const std::string& host,
+    uint64_t generation,
+    const adblock::UrlCosmeticResources& resources) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  entries_.Put(host, Entry{generation, resources});
+}
+
+}  // namespace brave_shields
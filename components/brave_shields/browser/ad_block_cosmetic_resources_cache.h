@@ -0,0 +1,57 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_COSMETIC_RESOURCES_CACHE_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_COSMETIC_RESOURCES_CACHE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+
+#include "base/containers/mru_cache.h"
+#include "base/sequence_checker.h"
+#include "brave/components/adblock_rust_ffi/src/wrapper.h"
+
+namespace brave_shields {
+
+// Bounded per-hostname cache of the merged cosmetic resources for a page.
+// Like AdBlockVerdictCache, entries are tagged with the engine generation they
+// were computed for. The cache is only used on the adblock task runner, so it
+// does not need its own locking.
+//
+// Cosmetic filters are keyed on the hostname by the engine, so frames on the
+// same host share an entry. The exception is `$generichide` rules that target
+// a path, which are rare enough that the cache ignores them.
+class AdBlockCosmeticResourcesCache {
+ public:
+  explicit AdBlockCosmeticResourcesCache(size_t size = 64);
+  ~AdBlockCosmeticResourcesCache();
+
+  AdBlockCosmeticResourcesCache(const AdBlockCosmeticResourcesCache&) = delete;
+  AdBlockCosmeticResourcesCache& operator=(
+      const AdBlockCosmeticResourcesCache&) = delete;
+
+  bool Get(const std::string& host,
+           uint64_t generation,
+           adblock::UrlCosmeticResources* resources);
+  void Put(const std::string& host,
+           uint64_t generation,
+           const adblock::UrlCosmeticResources& resources);
+
+ private:
+  struct Entry {
+    uint64_t generation;
+    adblock::UrlCosmeticResources resources;
+  };
+
+  base::MRUCache<std::string, Entry> entries_;
+
+  SEQUENCE_CHECKER(sequence_checker_);
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_COSMETIC_RESOURCES_CACHE_H_
@@ -0,0 +1,58 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/ad_block_cosmetic_resources_cache.h"
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace brave_shields {
+
+TEST(AdBlockCosmeticResourcesCacheTest, GetAndPut) {
+  AdBlockCosmeticResourcesCache cache;
+  adblock::UrlCosmeticResources resources;
+  EXPECT_FALSE(cache.Get("brave.com", 1, &resources));
+
+  adblock::UrlCosmeticResources stored;
+  stored.hide_selectors = {".ad"};
+  stored.style_selectors = {{".banner", {"display: none"}}};
+  stored.injected_script = "console.log('a')";
+  stored.generichide = true;
+  cache.Put("brave.com", 1, stored);
+
+  ASSERT_TRUE(cache.Get("brave.com", 1, &resources));
+  EXPECT_EQ(stored.hide_selectors, resources.hide_selectors);
+  EXPECT_EQ(stored.style_selectors, resources.style_selectors);
+  EXPECT_EQ(stored.injected_script, resources.injected_script);
+  EXPECT_TRUE(resources.generichide);
+
+  EXPECT_FALSE(cache.Get("www.brave.com", 1, &resources));
+}
+
+TEST(AdBlockCosmeticResourcesCacheTest, StaleGenerationIsEvicted) {
+  AdBlockCosmeticResourcesCache cache;
+  adblock::UrlCosmeticResources stored;
+  stored.hide_selectors = {".ad"};
+  cache.Put("brave.com", 1, stored);
+
+  adblock::UrlCosmeticResources resources;
+  EXPECT_FALSE(cache.Get("brave.com", 2, &resources));
+  // The stale entry was dropped, so going back to the old generation misses.
+  EXPECT_FALSE(cache.Get("brave.com", 1, &resources));
+}
+
+TEST(AdBlockCosmeticResourcesCacheTest, BoundedSize) {
+  AdBlockCosmeticResourcesCache cache(2);
+  adblock::UrlCosmeticResources stored;
+  cache.Put("a.com", 1, stored);
+  cache.Put("b.com", 1, stored);
+  cache.Put("c.com", 1, stored);
+
+  adblock::UrlCosmeticResources resources;
+  EXPECT_FALSE(cache.Get("a.com", 1, &resources));
+  EXPECT_TRUE(cache.Get("b.com", 1, &resources));
+  EXPECT_TRUE(cache.Get("c.com", 1, &resources));
+}
+
+}  // namespace brave_shields
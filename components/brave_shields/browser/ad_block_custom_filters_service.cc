@@ -5,9 +5,11 @@
 
 #include "brave/components/brave_shields/browser/ad_block_custom_filters_service.h"
 
+#include "base/feature_list.h"
 #include "base/logging.h"
 #include "brave/components/adblock_rust_ffi/src/wrapper.h"
 #include "brave/components/brave_shields/browser/ad_block_service.h"
+#include "brave/components/brave_shields/common/features.h"
 #include "brave/components/brave_shields/common/pref_names.h"
 #include "components/prefs/pref_service.h"
 #include "content/public/browser/browser_thread.h"
@@ -54,7 +56,11 @@ bool AdBlockCustomFiltersService::UpdateCustomFilters(
 void AdBlockCustomFiltersService::UpdateCustomFiltersOnFileTaskRunner(
     const std::string& custom_filters) {
   DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
+  // The custom filters are compiled into the merged engine instead.
+  if (base::FeatureList::IsEnabled(features::kBraveAdblockMergedListEngine))
+    return;
   ad_block_client_.reset(new adblock::Engine(custom_filters.c_str()));
+  IncrementEngineGeneration();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
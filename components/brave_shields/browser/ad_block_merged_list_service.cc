@@ -0,0 +1,105 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/ad_block_merged_list_service.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "base/bind.h"
+#include "base/files/file_util.h"
+#include "base/metrics/histogram_macros.h"
+#include "base/sequenced_task_runner.h"
+#include "base/task/thread_pool.h"
+#include "base/task_runner_util.h"
+#include "brave/components/adblock_rust_ffi/src/wrapper.h"
+#include "content/public/browser/browser_thread.h"
+
+namespace brave_shields {
+
+AdBlockMergedListService::CompiledEngine::CompiledEngine() = default;
+AdBlockMergedListService::CompiledEngine::CompiledEngine(CompiledEngine&&) =
+    default;
+AdBlockMergedListService::CompiledEngine&
+AdBlockMergedListService::CompiledEngine::operator=(CompiledEngine&&) =
+    default;
+AdBlockMergedListService::CompiledEngine::~CompiledEngine() = default;
+
+AdBlockMergedListService::AdBlockMergedListService(
+    BraveComponent::Delegate* delegate)
+    : AdBlockBaseService(delegate),
+      compile_task_runner_(base::ThreadPool::CreateSequencedTaskRunner(
+          {base::MayBlock(), base::TaskPriority::USER_VISIBLE,
+           base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN})) {}
+
+AdBlockMergedListService::~AdBlockMergedListService() {
+  DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
+}
+
+void AdBlockMergedListService::Rebuild(std::vector<MergedListSource> sources) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  GetTaskRunner()->PostTask(
+      FROM_HERE,
+      base::BindOnce(&AdBlockMergedListService::RebuildOnTaskRunner,
+                     weak_factory_.GetWeakPtr(), std::move(sources)));
+}
+
+void AdBlockMergedListService::RebuildOnTaskRunner(
+    std::vector<MergedListSource> sources) {
+  DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
+  // Compiles run on their own sequence and reply straight to the adblock task
+  // runner, so engines are installed in the order the rebuilds were requested.
+  base::PostTaskAndReplyWithResult(
+      compile_task_runner_.get(), FROM_HERE,
+      base::BindOnce(&AdBlockMergedListService::CompileOnThreadPool,
+                     std::move(sources)),
+      base::BindOnce(&AdBlockMergedListService::SetEngineOnTaskRunner,
+                     weak_factory_.GetWeakPtr()));
+}
+
+// static
+AdBlockMergedListService::CompiledEngine
+AdBlockMergedListService::CompileOnThreadPool(
+    std::vector<MergedListSource> sources) {
+  SCOPED_UMA_HISTOGRAM_TIMER("Brave.Adblock.MergedListEngine.CompileTime");
+  CompiledEngine compiled;
+  std::string merged_rules;
+  size_t line = 0;
+  for (auto& source : sources) {
+    std::string rules = std::move(source.rules);
+    if (!source.list_file.empty() &&
+        !base::ReadFileToString(source.list_file, &rules)) {
+      continue;
+    }
+    if (rules.empty())
+      continue;
+
+    // Every list starts on a fresh line so that rules from adjacent lists can
+    // never run together.
+    if (rules.back() != '\n')
+      rules.push_back('\n');
+    const size_t line_count = std::count(rules.begin(), rules.end(), '\n');
+    compiled.provenance.push_back({source.id, line, line_count});
+    line += line_count;
+    merged_rules.append(rules);
+  }
+
+  UMA_HISTOGRAM_COUNTS_100("Brave.Adblock.MergedListEngine.ListCount",
+                           compiled.provenance.size());
+  compiled.engine = std::make_unique<adblock::Engine>(merged_rules);
+  return compiled;
+}
+
+void AdBlockMergedListService::SetEngineOnTaskRunner(
+    CompiledEngine compiled) {
+  DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
+  ad_block_client_ = std::move(compiled.engine);
+  provenance_ = std::move(compiled.provenance);
+  AddKnownTagsToAdBlockInstance();
+  AddKnownResourcesToAdBlockInstance();
+  IncrementEngineGeneration();
+}
+
+}  // namespace brave_shields
@@ -0,0 +1,98 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_MERGED_LIST_SERVICE_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_MERGED_LIST_SERVICE_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/files/file_path.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/memory/weak_ptr.h"
+#include "brave/components/brave_shields/browser/ad_block_base_service.h"
+
+namespace base {
+class SequencedTaskRunner;
+}  // namespace base
+
+class AdBlockServiceTest;
+
+using brave_component_updater::BraveComponent;
+
+namespace brave_shields {
+
+// A filter list that contributes rules to the merged engine.
+struct MergedListSource {
+  // Identifies the list the rules came from, e.g. the subscription URL.
+  std::string id;
+  // Either the path to a plaintext list, or empty if `rules` is set.
+  base::FilePath list_file;
+  std::string rules;
+};
+
+// Records which lines of the merged rule text came from which list.
+struct MergedListProvenance {
+  std::string id;
+  size_t first_line;
+  size_t line_count;
+};
+
+// The brave shields service that compiles every plaintext filter list (list
+// subscriptions and custom filters) into a single adblock engine, so that a
+// request is tokenized and matched once regardless of how many of those lists
+// are enabled. Used in place of the per-list engines when
+// `kBraveAdblockMergedListEngine` is enabled.
+//
+// Must be destroyed on the adblock task runner (see base::OnTaskRunnerDeleter)
+// so that engine swaps already posted there never outlive the service.
+class AdBlockMergedListService : public AdBlockBaseService {
+ public:
+  explicit AdBlockMergedListService(BraveComponent::Delegate* delegate);
+  ~AdBlockMergedListService() override;
+
+  // Recompiles the merged engine from `sources` in the background and swaps
+  // it in on the adblock task runner once ready. Rebuilds are compiled one at
+  // a time, in order, so an older engine never replaces a newer one.
+  void Rebuild(std::vector<MergedListSource> sources);
+
+  // Must be called on the adblock task runner.
+  const std::vector<MergedListProvenance>& provenance() const {
+    return provenance_;
+  }
+
+ private:
+  friend class ::AdBlockServiceTest;
+
+  struct CompiledEngine {
+    CompiledEngine();
+    CompiledEngine(CompiledEngine&&);
+    CompiledEngine& operator=(CompiledEngine&&);
+    ~CompiledEngine();
+
+    std::unique_ptr<adblock::Engine> engine;
+    std::vector<MergedListProvenance> provenance;
+  };
+
+  static CompiledEngine CompileOnThreadPool(
+      std::vector<MergedListSource> sources);
+  void RebuildOnTaskRunner(std::vector<MergedListSource> sources);
+  void SetEngineOnTaskRunner(CompiledEngine compiled);
+
+  scoped_refptr<base::SequencedTaskRunner> compile_task_runner_;
+  std::vector<MergedListProvenance> provenance_;
+
+  // Only dereferenced and invalidated on the adblock task runner.
+  base::WeakPtrFactory<AdBlockMergedListService> weak_factory_{this};
+
+  AdBlockMergedListService(const AdBlockMergedListService&) = delete;
+  AdBlockMergedListService& operator=(const AdBlockMergedListService&) =
+      delete;
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_MERGED_LIST_SERVICE_H_
@@ -7,6 +7,7 @@
 
 #include "base/bind.h"
 #include "brave/components/brave_shields/browser/ad_block_custom_filters_service.h"
+#include "brave/components/brave_shields/browser/ad_block_merged_list_service.h"
 #include "brave/components/brave_shields/browser/ad_block_regional_service_manager.h"
 #include "brave/components/brave_shields/browser/ad_block_service.h"
 #include "brave/components/brave_shields/browser/ad_block_subscription_service_manager.h"
@@ -70,6 +71,8 @@ void AdBlockPrefService::OnPreferenceChanged(const std::string& pref_name) {
   ad_block_service_->regional_service_manager()->EnableTag(tag, enabled);
   ad_block_service_->custom_filters_service()->EnableTag(tag, enabled);
   ad_block_service_->subscription_service_manager()->EnableTag(tag, enabled);
+  if (ad_block_service_->merged_list_service())
+    ad_block_service_->merged_list_service()->EnableTag(tag, enabled);
 }
 
 }  // namespace brave_shields
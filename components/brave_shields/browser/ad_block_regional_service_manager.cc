@@ -205,61 +205,41 @@ void AdBlockRegionalServiceManager::EnableFilterList(
                      base::Unretained(this), uuid, enabled));
 }
 
-absl::optional<base::Value> AdBlockRegionalServiceManager::UrlCosmeticResources(
-    const std::string& url) {
+absl::optional<adblock::UrlCosmeticResources>
+AdBlockRegionalServiceManager::UrlCosmeticResources(const std::string& url) {
   base::AutoLock lock(regional_services_lock_);
   auto it = regional_services_.begin();
   if (it == regional_services_.end()) {
-    return absl::optional<base::Value>();
+    return absl::nullopt;
   }
-  absl::optional<base::Value> first_value =
+  adblock::UrlCosmeticResources first_value =
       it->second->UrlCosmeticResources(url);
 
-  for ( ; it != regional_services_.end(); it++) {
-    absl::optional<base::Value> next_value =
-        it->second->UrlCosmeticResources(url);
-    if (first_value) {
-      if (next_value) {
-        MergeResourcesInto(std::move(*next_value), &*first_value, false);
-      }
-    } else {
-      first_value = std::move(next_value);
-    }
+  for (it++; it != regional_services_.end(); it++) {
+    MergeResourcesInto(it->second->UrlCosmeticResources(url), &first_value,
+                       false);
   }
 
   return first_value;
 }
 
-absl::optional<base::Value>
-AdBlockRegionalServiceManager::HiddenClassIdSelectors(
+std::vector<std::string> AdBlockRegionalServiceManager::HiddenClassIdSelectors(
     const std::vector<std::string>& classes,
     const std::vector<std::string>& ids,
     const std::vector<std::string>& exceptions) {
   base::AutoLock lock(regional_services_lock_);
-  auto it = regional_services_.begin();
-  if (it == regional_services_.end()) {
-    return absl::optional<base::Value>();
-  }
-  absl::optional<base::Value> first_value =
-      it->second->HiddenClassIdSelectors(classes, ids, exceptions);
-
-  for ( ; it != regional_services_.end(); it++) {
-    absl::optional<base::Value> next_value =
-        it->second->HiddenClassIdSelectors(classes, ids, exceptions);
-    if (first_value && first_value->is_list()) {
-      if (next_value && next_value->is_list()) {
-        for (auto i = next_value->GetList().begin();
-                i < next_value->GetList().end();
-                i++) {
-          first_value->Append(std::move(*i));
-        }
-      }
-    } else {
-      first_value = std::move(next_value);
-    }
+  std::vector<std::string> selectors;
+
+  for (const auto& regional_service : regional_services_) {
+    std::vector<std::string> next_selectors =
+        regional_service.second->HiddenClassIdSelectors(classes, ids,
+                                                        exceptions);
+    selectors.insert(selectors.end(),
+                     std::make_move_iterator(next_selectors.begin()),
+                     std::make_move_iterator(next_selectors.end()));
   }
 
-  return first_value;
+  return selectors;
 }
 
 void AdBlockRegionalServiceManager::SetRegionalCatalog(
@@ -7,6 +7,7 @@
 
 #include <algorithm>
 #include <utility>
+#include <vector>
 
 #include "base/base_paths.h"
 #include "base/bind.h"
@@ -20,6 +21,7 @@
 #include "base/threading/thread_restrictions.h"
 #include "brave/components/adblock_rust_ffi/src/wrapper.h"
 #include "brave/components/brave_shields/browser/ad_block_custom_filters_service.h"
+#include "brave/components/brave_shields/browser/ad_block_merged_list_service.h"
 #include "brave/components/brave_shields/browser/ad_block_regional_service_manager.h"
 #include "brave/components/brave_shields/browser/ad_block_service_helper.h"
 #include "brave/components/brave_shields/browser/ad_block_subscription_service_manager.h"
@@ -31,6 +33,7 @@
 #include "components/prefs/pref_service.h"
 #include "net/base/registry_controlled_domains/registry_controlled_domain.h"
 #include "third_party/abseil-cpp/absl/types/optional.h"
+#include "url/gurl.h"
 #include "url/origin.h"
 
 #define DAT_FILE "rs-ABPFilterParserData.dat"
@@ -76,6 +79,48 @@ void AdBlockService::ShouldStartRequest(
   if (!IsInitialized())
     return;
 
+  // The engines skip work based on flags set by earlier queries (e.g. before
+  // CNAME uncloaking), so only fresh queries can be served from the cache.
+  const bool is_fresh_query = !*did_match_rule && !*did_match_exception &&
+                              !(did_match_important && *did_match_important);
+  if (!is_fresh_query) {
+    ShouldStartRequestUncached(url, resource_type, tab_host,
+                               aggressive_blocking, did_match_rule,
+                               did_match_exception, did_match_important,
+                               mock_data_url);
+    return;
+  }
+
+  const uint64_t generation = GetEngineGeneration();
+  const AdBlockVerdictCache::Key key = AdBlockVerdictCache::MakeKey(
+      url, resource_type, tab_host, aggressive_blocking);
+  AdBlockVerdict verdict;
+  if (!verdict_cache_.Get(key, generation, &verdict)) {
+    ShouldStartRequestUncached(url, resource_type, tab_host,
+                               aggressive_blocking, &verdict.did_match_rule,
+                               &verdict.did_match_exception,
+                               &verdict.did_match_important,
+                               &verdict.mock_data_url);
+    verdict_cache_.Put(key, generation, verdict);
+  }
+
+  *did_match_rule = verdict.did_match_rule;
+  *did_match_exception = verdict.did_match_exception;
+  if (did_match_important)
+    *did_match_important = verdict.did_match_important;
+  if (mock_data_url && !verdict.mock_data_url.empty())
+    *mock_data_url = verdict.mock_data_url;
+}
+
+void AdBlockService::ShouldStartRequestUncached(
+    const GURL& url,
+    blink::mojom::ResourceType resource_type,
+    const std::string& tab_host,
+    bool aggressive_blocking,
+    bool* did_match_rule,
+    bool* did_match_exception,
+    bool* did_match_important,
+    std::string* mock_data_url) {
   if (aggressive_blocking ||
       base::FeatureList::IsEnabled(
           brave_shields::features::kBraveAdblockDefault1pBlocking) ||
@@ -97,6 +142,13 @@ void AdBlockService::ShouldStartRequest(
     return;
   }
 
+  if (merged_list_service_) {
+    merged_list_service_->ShouldStartRequest(
+        url, resource_type, tab_host, aggressive_blocking, did_match_rule,
+        did_match_exception, did_match_important, mock_data_url);
+    return;
+  }
+
   subscription_service_manager()->ShouldStartRequest(
       url, resource_type, tab_host, aggressive_blocking, did_match_rule,
       did_match_exception, did_match_important, mock_data_url);
@@ -121,98 +173,109 @@ absl::optional<std::string> AdBlockService::GetCspDirectives(
   MergeCspDirectiveInto(regional_csp, &csp_directives);
 
   const auto custom_csp =
-      custom_filters_service()->GetCspDirectives(url, resource_type, tab_host);
+      merged_list_service_
+          ? merged_list_service_->GetCspDirectives(url, resource_type, tab_host)
+          : custom_filters_service()->GetCspDirectives(url, resource_type,
+                                                       tab_host);
   MergeCspDirectiveInto(custom_csp, &csp_directives);
 
   return csp_directives;
 }
 
-absl::optional<base::Value> AdBlockService::UrlCosmeticResources(
+adblock::UrlCosmeticResources AdBlockService::UrlCosmeticResources(
     const std::string& url) {
-  absl::optional<base::Value> resources =
-      AdBlockBaseService::UrlCosmeticResources(url);
-
-  if (!resources || !resources->is_dict()) {
-    return resources;
+  DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
+  const GURL gurl(url);
+  if (!gurl.is_valid() || !gurl.has_host())
+    return UrlCosmeticResourcesUncached(url);
+
+  const uint64_t generation = GetEngineGeneration();
+  adblock::UrlCosmeticResources resources;
+  if (!cosmetic_resources_cache_.Get(gurl.host(), generation, &resources)) {
+    resources = UrlCosmeticResourcesUncached(url);
+    cosmetic_resources_cache_.Put(gurl.host(), generation, resources);
   }
+  return resources;
+}
+
+void AdBlockService::PrefetchUrlCosmeticResources(const GURL& url) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  if (!url.SchemeIsHTTPOrHTTPS())
+    return;
+
+  GetTaskRunner()->PostTask(
+      FROM_HERE,
+      base::BindOnce(
+          base::IgnoreResult(&AdBlockService::UrlCosmeticResources),
+          base::Unretained(this), url.spec()));
+}
+
+adblock::UrlCosmeticResources AdBlockService::UrlCosmeticResourcesUncached(
+    const std::string& url) {
+  adblock::UrlCosmeticResources resources =
+      AdBlockBaseService::UrlCosmeticResources(url);
 
-  absl::optional<base::Value> regional_resources =
+  absl::optional<adblock::UrlCosmeticResources> regional_resources =
       regional_service_manager()->UrlCosmeticResources(url);
 
-  if (regional_resources && regional_resources->is_dict()) {
-    MergeResourcesInto(std::move(*regional_resources), &*resources,
+  if (regional_resources) {
+    MergeResourcesInto(std::move(*regional_resources), &resources,
                        /*force_hide=*/false);
   }
 
-  absl::optional<base::Value> custom_resources =
-      custom_filters_service()->UrlCosmeticResources(url);
-
-  if (custom_resources && custom_resources->is_dict()) {
-    MergeResourcesInto(std::move(*custom_resources), &*resources,
-                       /*force_hide=*/true);
+  if (merged_list_service_) {
+    MergeResourcesInto(merged_list_service_->UrlCosmeticResources(url),
+                       &resources, /*force_hide=*/true);
+    return resources;
   }
 
-  absl::optional<base::Value> subscription_resources =
+  MergeResourcesInto(custom_filters_service()->UrlCosmeticResources(url),
+                     &resources, /*force_hide=*/true);
+
+  absl::optional<adblock::UrlCosmeticResources> subscription_resources =
       subscription_service_manager()->UrlCosmeticResources(url);
 
-  if (subscription_resources && subscription_resources->is_dict()) {
-    MergeResourcesInto(std::move(*subscription_resources), &*resources,
+  if (subscription_resources) {
+    MergeResourcesInto(std::move(*subscription_resources), &resources,
                        /*force_hide=*/true);
   }
 
   return resources;
 }
 
-absl::optional<base::Value> AdBlockService::HiddenClassIdSelectors(
+std::vector<std::string> AdBlockService::HiddenClassIdSelectors(
     const std::vector<std::string>& classes,
     const std::vector<std::string>& ids,
     const std::vector<std::string>& exceptions) {
-  absl::optional<base::Value> hide_selectors =
+  std::vector<std::string> hide_selectors =
       AdBlockBaseService::HiddenClassIdSelectors(classes, ids, exceptions);
 
-  absl::optional<base::Value> regional_selectors =
+  std::vector<std::string> regional_selectors =
       regional_service_manager()->HiddenClassIdSelectors(classes, ids,
                                                          exceptions);
-
-  if (hide_selectors && hide_selectors->is_list()) {
-    if (regional_selectors && regional_selectors->is_list()) {
-      for (auto i = regional_selectors->GetList().begin();
-           i < regional_selectors->GetList().end(); i++) {
-        hide_selectors->Append(std::move(*i));
-      }
-    }
-  } else {
-    hide_selectors = std::move(regional_selectors);
-  }
-
-  absl::optional<base::Value> custom_selectors =
-      custom_filters_service()->HiddenClassIdSelectors(classes, ids,
-                                                       exceptions);
-
-  absl::optional<base::Value> subscription_selectors =
-      subscription_service_manager()->HiddenClassIdSelectors(classes, ids,
-                                                             exceptions);
-
-  if (custom_selectors && custom_selectors->is_list()) {
-    if (subscription_selectors && subscription_selectors->is_list()) {
-      for (auto i = subscription_selectors->GetList().begin();
-           i < subscription_selectors->GetList().end(); i++) {
-        custom_selectors->Append(std::move(*i));
-      }
-    }
+  hide_selectors.insert(hide_selectors.end(),
+                        std::make_move_iterator(regional_selectors.begin()),
+                        std::make_move_iterator(regional_selectors.end()));
+
+  std::vector<std::string> custom_selectors;
+  if (merged_list_service_) {
+    custom_selectors =
+        merged_list_service_->HiddenClassIdSelectors(classes, ids, exceptions);
   } else {
-    custom_selectors = std::move(subscription_selectors);
+    custom_selectors = custom_filters_service()->HiddenClassIdSelectors(
+        classes, ids, exceptions);
+    std::vector<std::string> subscription_selectors =
+        subscription_service_manager()->HiddenClassIdSelectors(classes, ids,
+                                                               exceptions);
+    custom_selectors.insert(
+        custom_selectors.end(),
+        std::make_move_iterator(subscription_selectors.begin()),
+        std::make_move_iterator(subscription_selectors.end()));
   }
 
-  if (!hide_selectors || !hide_selectors->is_list())
-    hide_selectors = base::ListValue();
-
-  if (custom_selectors && custom_selectors->is_list()) {
-    for (auto i = custom_selectors->GetList().begin();
-         i < custom_selectors->GetList().end(); i++) {
-      hide_selectors->Append(std::move(*i));
-    }
-  }
+  hide_selectors.insert(hide_selectors.end(),
+                        std::make_move_iterator(custom_selectors.begin()),
+                        std::make_move_iterator(custom_selectors.end()));
 
   return hide_selectors;
 }
@@ -238,15 +301,57 @@ AdBlockService::subscription_service_manager() {
   return subscription_service_manager_.get();
 }
 
+brave_shields::AdBlockMergedListService*
+AdBlockService::merged_list_service() {
+  return merged_list_service_.get();
+}
+
+void AdBlockService::OnSubscriptionListsChanged() {
+  RebuildMergedListEngine();
+}
+
+void AdBlockService::RebuildMergedListEngine() {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  if (!merged_list_service_)
+    return;
+
+  std::vector<MergedListSource> sources;
+  for (auto& list_file :
+       subscription_service_manager()->GetEnabledListFiles()) {
+    MergedListSource source;
+    source.id = list_file.first.spec();
+    source.list_file = std::move(list_file.second);
+    sources.push_back(std::move(source));
+  }
+
+  MergedListSource custom_filters;
+  custom_filters.id = "custom_filters";
+  custom_filters.rules = custom_filters_service()->GetCustomFilters();
+  sources.push_back(std::move(custom_filters));
+
+  merged_list_service_->Rebuild(std::move(sources));
+}
+
 AdBlockService::AdBlockService(
     brave_component_updater::BraveComponent::Delegate* delegate,
     std::unique_ptr<AdBlockSubscriptionServiceManager>
         subscription_service_manager)
     : AdBlockBaseService(delegate),
       component_delegate_(delegate),
-      subscription_service_manager_(std::move(subscription_service_manager)) {}
+      subscription_service_manager_(std::move(subscription_service_manager)),
+      merged_list_service_(nullptr, base::OnTaskRunnerDeleter(nullptr)) {
+  if (base::FeatureList::IsEnabled(features::kBraveAdblockMergedListEngine)) {
+    merged_list_service_ =
+        std::unique_ptr<AdBlockMergedListService, base::OnTaskRunnerDeleter>(
+            new AdBlockMergedListService(component_delegate_),
+            base::OnTaskRunnerDeleter(GetTaskRunner()));
+  }
+}
 
-AdBlockService::~AdBlockService() {}
+AdBlockService::~AdBlockService() {
+  if (merged_list_service_)
+    subscription_service_manager()->RemoveObserver(this);
+}
 
 bool AdBlockService::Init() {
   // Initializes adblock-rust's domain resolution implementation
@@ -267,6 +372,19 @@ void AdBlockService::OnComponentReady(const std::string& component_id,
   custom_filters_service()->Start();
   subscription_service_manager()->Start();
 
+  if (merged_list_service_ && !pref_change_registrar_ &&
+      component_delegate_->local_state()) {
+    merged_list_service_->Start();
+    subscription_service_manager()->AddObserver(this);
+    pref_change_registrar_ = std::make_unique<PrefChangeRegistrar>();
+    pref_change_registrar_->Init(component_delegate_->local_state());
+    pref_change_registrar_->Add(
+        prefs::kAdBlockCustomFilters,
+        base::BindRepeating(&AdBlockService::RebuildMergedListEngine,
+                            base::Unretained(this)));
+    RebuildMergedListEngine();
+  }
+
   base::FilePath dat_file_path = install_dir.AppendASCII(DAT_FILE);
   GetDATFileData(dat_file_path);
 
@@ -292,6 +410,8 @@ void AdBlockService::OnComponentReady(const std::string& component_id,
 void AdBlockService::OnResourcesFileDataReady(const std::string& resources) {
   AddResources(resources);
   custom_filters_service()->AddResources(resources);
+  if (merged_list_service_)
+    merged_list_service_->AddResources(resources);
 }
 
 void AdBlockService::OnRegionalCatalogFileDataReady(
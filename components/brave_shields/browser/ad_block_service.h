@@ -12,8 +12,12 @@
 #include <string>
 #include <vector>
 
+#include "base/sequenced_task_runner.h"
 #include "base/values.h"
 #include "brave/components/brave_shields/browser/ad_block_base_service.h"
+#include "brave/components/brave_shields/browser/ad_block_cosmetic_resources_cache.h"
+#include "brave/components/brave_shields/browser/ad_block_subscription_service_manager_observer.h"
+#include "brave/components/brave_shields/browser/ad_block_verdict_cache.h"
 #include "components/keyed_service/core/keyed_service.h"
 #include "components/prefs/pref_registry_simple.h"
 #include "content/public/browser/browser_thread.h"
@@ -30,6 +34,7 @@ namespace brave_shields {
 
 class AdBlockRegionalServiceManager;
 class AdBlockCustomFiltersService;
+class AdBlockMergedListService;
 class AdBlockSubscriptionServiceManager;
 
 const char kAdBlockResourcesFilename[] = "resources.json";
@@ -45,7 +50,8 @@ const char kAdBlockComponentBase64PublicKey[] =
     "VwIDAQAB";
 
 // The brave shields service in charge of ad-block checking and init.
-class AdBlockService : public AdBlockBaseService {
+class AdBlockService : public AdBlockBaseService,
+                       public AdBlockSubscriptionServiceManagerObserver {
  public:
   explicit AdBlockService(
       BraveComponent::Delegate* delegate,
@@ -64,9 +70,13 @@ class AdBlockService : public AdBlockBaseService {
       const GURL& url,
       blink::mojom::ResourceType resource_type,
       const std::string& tab_host);
-  absl::optional<base::Value> UrlCosmeticResources(
+  adblock::UrlCosmeticResources UrlCosmeticResources(
       const std::string& url) override;
-  absl::optional<base::Value> HiddenClassIdSelectors(
+  // Computes the cosmetic resources for |url| ahead of the renderer asking
+  // for them, so that the renderer's request is served from the cache. Must be
+  // called on the UI thread.
+  void PrefetchUrlCosmeticResources(const GURL& url);
+  std::vector<std::string> HiddenClassIdSelectors(
       const std::vector<std::string>& classes,
       const std::vector<std::string>& ids,
       const std::vector<std::string>& exceptions) override;
@@ -74,6 +84,11 @@ class AdBlockService : public AdBlockBaseService {
   AdBlockRegionalServiceManager* regional_service_manager();
   AdBlockCustomFiltersService* custom_filters_service();
   AdBlockSubscriptionServiceManager* subscription_service_manager();
+  // Returns nullptr unless `kBraveAdblockMergedListEngine` is enabled.
+  AdBlockMergedListService* merged_list_service();
+
+  // AdBlockSubscriptionServiceManagerObserver:
+  void OnSubscriptionListsChanged() override;
 
  protected:
   bool Init() override;
@@ -93,14 +108,36 @@ class AdBlockService : public AdBlockBaseService {
       const std::string& component_id,
       const std::string& component_base64_public_key);
 
+  void ShouldStartRequestUncached(const GURL& url,
+                                  blink::mojom::ResourceType resource_type,
+                                  const std::string& tab_host,
+                                  bool aggressive_blocking,
+                                  bool* did_match_rule,
+                                  bool* did_match_exception,
+                                  bool* did_match_important,
+                                  std::string* mock_data_url);
+
+  adblock::UrlCosmeticResources UrlCosmeticResourcesUncached(
+      const std::string& url);
+
+  void RebuildMergedListEngine();
+
   BraveComponent::Delegate* component_delegate_;
 
+  AdBlockVerdictCache verdict_cache_;
+  AdBlockCosmeticResourcesCache cosmetic_resources_cache_;
+
   std::unique_ptr<brave_shields::AdBlockRegionalServiceManager>
       regional_service_manager_;
   std::unique_ptr<brave_shields::AdBlockCustomFiltersService>
       custom_filters_service_;
   std::unique_ptr<brave_shields::AdBlockSubscriptionServiceManager>
       subscription_service_manager_;
+  // Deleted on the adblock task runner, after any work already posted there.
+  std::unique_ptr<brave_shields::AdBlockMergedListService,
+                  base::OnTaskRunnerDeleter>
+      merged_list_service_;
+  std::unique_ptr<PrefChangeRegistrar> pref_change_registrar_;
 
   base::WeakPtrFactory<AdBlockService> weak_factory_{this};
   DISALLOW_COPY_AND_ASSIGN(AdBlockService);
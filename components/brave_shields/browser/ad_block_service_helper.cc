@@ -139,80 +139,45 @@ void MergeCspDirectiveInto(absl::optional<std::string> from,
   *into = absl::optional<std::string>(from_str + ", " + into_str);
 }
 
-// Merges the contents of the first UrlCosmeticResources Value into the second
-// one provided.
+// Merges the contents of the first UrlCosmeticResources into the second one
+// provided.
 //
 // If `force_hide` is true, the contents of `from`'s `hide_selectors` field
-// will be moved into a possibly new field of `into` called
-// `force_hide_selectors`.
-void MergeResourcesInto(base::Value from, base::Value* into, bool force_hide) {
-  base::Value* resources_hide_selectors = nullptr;
-  if (force_hide) {
-    resources_hide_selectors = into->FindKey("force_hide_selectors");
-    if (!resources_hide_selectors || !resources_hide_selectors->is_list()) {
-        into->SetKey("force_hide_selectors", base::ListValue());
-        resources_hide_selectors = into->FindKey("force_hide_selectors");
-    }
+// will be moved into the `force_hide_selectors` field of `into`.
+void MergeResourcesInto(adblock::UrlCosmeticResources from,
+                        adblock::UrlCosmeticResources* into,
+                        bool force_hide) {
+  DCHECK(into);
+
+  std::vector<std::string>* resources_hide_selectors =
+      force_hide ? &into->force_hide_selectors : &into->hide_selectors;
+  if (resources_hide_selectors->empty()) {
+    *resources_hide_selectors = std::move(from.hide_selectors);
   } else {
-    resources_hide_selectors = into->FindKey("hide_selectors");
-  }
-  base::Value* from_resources_hide_selectors =
-      from.FindKey("hide_selectors");
-  if (resources_hide_selectors && from_resources_hide_selectors) {
-    for (auto i = from_resources_hide_selectors->GetList().begin();
-            i < from_resources_hide_selectors->GetList().end();
-            i++) {
-      resources_hide_selectors->Append(std::move(*i));
-    }
+    resources_hide_selectors->insert(
+        resources_hide_selectors->end(),
+        std::make_move_iterator(from.hide_selectors.begin()),
+        std::make_move_iterator(from.hide_selectors.end()));
   }
 
-  base::Value* resources_style_selectors = into->FindKey("style_selectors");
-  base::Value* from_resources_style_selectors =
-      from.FindKey("style_selectors");
-  if (resources_style_selectors && from_resources_style_selectors) {
-    for (auto i : from_resources_style_selectors->DictItems()) {
-      base::Value* resources_entry =
-          resources_style_selectors->FindKey(i.first);
-      if (resources_entry) {
-        for (auto j = i.second.GetList().begin();
-                j < i.second.GetList().end();
-                j++) {
-          resources_entry->Append(std::move(*j));
-        }
-      } else {
-        resources_style_selectors->SetKey(i.first, std::move(i.second));
-      }
-    }
+  for (auto& style_selector : from.style_selectors) {
+    std::vector<std::string>& resources_entry =
+        into->style_selectors[style_selector.first];
+    resources_entry.insert(
+        resources_entry.end(),
+        std::make_move_iterator(style_selector.second.begin()),
+        std::make_move_iterator(style_selector.second.end()));
   }
 
-  base::Value* resources_exceptions = into->FindKey("exceptions");
-  base::Value* from_resources_exceptions = from.FindKey("exceptions");
-  if (resources_exceptions && from_resources_exceptions) {
-    for (auto i = from_resources_exceptions->GetList().begin();
-            i < from_resources_exceptions->GetList().end();
-            i++) {
-      resources_exceptions->Append(std::move(*i));
-    }
-  }
+  into->exceptions.insert(into->exceptions.end(),
+                          std::make_move_iterator(from.exceptions.begin()),
+                          std::make_move_iterator(from.exceptions.end()));
 
-  base::Value* resources_injected_script = into->FindKey("injected_script");
-  base::Value* from_resources_injected_script =
-      from.FindKey("injected_script");
-  if (resources_injected_script && from_resources_injected_script) {
-    *resources_injected_script = base::Value(
-            resources_injected_script->GetString()
-            + '\n'
-            + from_resources_injected_script->GetString());
-  }
+  into->injected_script += '\n';
+  into->injected_script += from.injected_script;
 
-  base::Value* resources_generichide = into->FindKey("generichide");
-  base::Value* from_resources_generichide =
-      from.FindKey("generichide");
-  if (from_resources_generichide) {
-    if (from_resources_generichide->GetBool()) {
-      *resources_generichide = base::Value(true);
-    }
-  }
+  if (from.generichide)
+    into->generichide = true;
 }
 
 }  // namespace brave_shields
@@ -29,7 +29,9 @@ std::vector<adblock::FilterList> RegionalCatalogFromJSON(
 void MergeCspDirectiveInto(absl::optional<std::string> from,
                            absl::optional<std::string>* into);
 
-void MergeResourcesInto(base::Value from, base::Value* into, bool force_hide);
+void MergeResourcesInto(adblock::UrlCosmeticResources from,
+                        adblock::UrlCosmeticResources* into,
+                        bool force_hide);
 
 }  // namespace brave_shields
 
@@ -5,6 +5,7 @@
 
 #include "brave/components/brave_shields/browser/ad_block_subscription_service.h"
 
+#include "base/feature_list.h"
 #include "base/files/file_path.h"
 #include "base/json/json_value_converter.h"
 #include "base/json/values_util.h"
@@ -13,6 +14,7 @@
 #include "brave/components/brave_shields/browser/ad_block_service.h"
 #include "brave/components/brave_shields/browser/ad_block_service_helper.h"
 #include "brave/components/brave_shields/common/brave_shield_constants.h"
+#include "brave/components/brave_shields/common/features.h"
 
 namespace brave_shields {
 
@@ -75,6 +77,12 @@ bool AdBlockSubscriptionService::Init() {
 }
 
 void AdBlockSubscriptionService::ReloadList() {
+  // The list text is compiled into the merged engine instead.
+  if (base::FeatureList::IsEnabled(features::kBraveAdblockMergedListEngine)) {
+    OnListLoaded();
+    return;
+  }
+
   GetDATFileData(list_file_, false,
                  base::BindOnce(&AdBlockSubscriptionService::OnListLoaded,
                                 weak_factory_.GetWeakPtr()));
@@ -20,6 +20,7 @@
 #include "base/time/time.h"
 #include "base/values.h"
 #include "brave/components/adblock_rust_ffi/src/wrapper.h"
+#include "brave/components/brave_shields/browser/ad_block_base_service.h"
 #include "brave/components/brave_shields/browser/ad_block_service_helper.h"
 #include "brave/components/brave_shields/browser/ad_block_subscription_service.h"
 #include "brave/components/brave_shields/browser/ad_block_subscription_service_manager_observer.h"
@@ -193,6 +194,23 @@ AdBlockSubscriptionServiceManager::GetSubscriptions() {
   return infos;
 }
 
+std::vector<std::pair<GURL, base::FilePath>>
+AdBlockSubscriptionServiceManager::GetEnabledListFiles() {
+  DCHECK_CALLED_ON_VALID_THREAD(thread_checker_);
+  std::vector<std::pair<GURL, base::FilePath>> list_files;
+
+  for (const auto& subscription_service : subscription_services_) {
+    auto info = GetInfo(subscription_service.first);
+    if (info && info->enabled) {
+      list_files.emplace_back(subscription_service.first,
+                              GetSubscriptionPath(subscription_service.first)
+                                  .Append(kCustomSubscriptionListText));
+    }
+  }
+
+  return list_files;
+}
+
 void AdBlockSubscriptionServiceManager::EnableSubscription(const GURL& sub_url,
                                                            bool enabled) {
   DCHECK_CALLED_ON_VALID_THREAD(thread_checker_);
@@ -202,6 +220,10 @@ void AdBlockSubscriptionServiceManager::EnableSubscription(const GURL& sub_url,
   info->enabled = enabled;
 
   UpdateSubscriptionPrefs(sub_url, *info);
+  AdBlockBaseService::IncrementEngineGeneration();
+
+  NotifyObserversOfListsChanged();
+  NotifyObserversOfServiceEvent();
 }
 
 void AdBlockSubscriptionServiceManager::DeleteSubscription(
@@ -214,6 +236,8 @@ void AdBlockSubscriptionServiceManager::DeleteSubscription(
     subscription_services_.erase(it);
   }
   ClearSubscriptionPrefs(sub_url);
+  NotifyObserversOfListsChanged();
+  NotifyObserversOfServiceEvent();
 
   base::ThreadPool::PostTask(
       FROM_HERE,
@@ -247,6 +271,8 @@ void AdBlockSubscriptionServiceManager::OnGetDownloadManager(
 
   download_manager_->CancelAllPendingDownloads();
   LoadSubscriptionServices();
+  NotifyObserversOfListsChanged();
+  NotifyObserversOfServiceEvent();
 
   subscription_update_timer_->Schedule(
       kListCheckInitialDelay, kListRetryInterval,
@@ -401,22 +427,20 @@ void AdBlockSubscriptionServiceManager::AddResources(
   }
 }
 
-absl::optional<base::Value>
+absl::optional<adblock::UrlCosmeticResources>
 AdBlockSubscriptionServiceManager::UrlCosmeticResources(
     const std::string& url) {
-  absl::optional<base::Value> first_value = absl::nullopt;
+  absl::optional<adblock::UrlCosmeticResources> first_value = absl::nullopt;
 
   base::AutoLock lock(subscription_services_lock_);
   for (auto it = subscription_services_.begin();
        it != subscription_services_.end(); it++) {
     auto info = GetInfo(it->first);
     if (info && info->enabled) {
-      absl::optional<base::Value> next_value =
+      adblock::UrlCosmeticResources next_value =
           it->second->UrlCosmeticResources(url);
       if (first_value) {
-        if (next_value) {
-          MergeResourcesInto(std::move(*next_value), &*first_value, false);
-        }
+        MergeResourcesInto(std::move(next_value), &*first_value, false);
       } else {
         first_value = std::move(next_value);
       }
@@ -426,34 +450,27 @@ AdBlockSubscriptionServiceManager::UrlCosmeticResources(
   return first_value;
 }
 
-absl::optional<base::Value>
+std::vector<std::string>
 AdBlockSubscriptionServiceManager::HiddenClassIdSelectors(
     const std::vector<std::string>& classes,
     const std::vector<std::string>& ids,
     const std::vector<std::string>& exceptions) {
-  absl::optional<base::Value> first_value = absl::nullopt;
+  std::vector<std::string> selectors;
 
   base::AutoLock lock(subscription_services_lock_);
   for (auto it = subscription_services_.begin();
        it != subscription_services_.end(); it++) {
     auto info = GetInfo(it->first);
     if (info && info->enabled) {
-      absl::optional<base::Value> next_value =
+      std::vector<std::string> next_selectors =
           it->second->HiddenClassIdSelectors(classes, ids, exceptions);
-      if (first_value && first_value->is_list()) {
-        if (next_value && next_value->is_list()) {
-          for (auto i = next_value->GetList().begin();
-               i < next_value->GetList().end(); i++) {
-            first_value->Append(std::move(*i));
-          }
-        }
-      } else {
-        first_value = std::move(next_value);
-      }
+      selectors.insert(selectors.end(),
+                       std::make_move_iterator(next_selectors.begin()),
+                       std::make_move_iterator(next_selectors.end()));
     }
   }
 
-  return first_value;
+  return selectors;
 }
 
 void AdBlockSubscriptionServiceManager::OnSubscriptionDownloaded(
@@ -473,6 +490,7 @@ void AdBlockSubscriptionServiceManager::OnSubscriptionDownloaded(
 
   it->second->ReloadList();
 
+  NotifyObserversOfListsChanged();
   NotifyObserversOfServiceEvent();
 }
 
@@ -488,6 +506,12 @@ void AdBlockSubscriptionServiceManager::OnSubscriptionDownloadFailure(
   NotifyObserversOfServiceEvent();
 }
 
+void AdBlockSubscriptionServiceManager::NotifyObserversOfListsChanged() {
+  for (auto& observer : observers_) {
+    observer.OnSubscriptionListsChanged();
+  }
+}
+
 void AdBlockSubscriptionServiceManager::NotifyObserversOfServiceEvent() {
   for (auto& observer : observers_) {
     observer.OnServiceUpdateEvent();
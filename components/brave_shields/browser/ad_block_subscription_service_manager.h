@@ -9,6 +9,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "base/files/file_path.h"
@@ -52,6 +53,9 @@ class AdBlockSubscriptionServiceManager {
   GURL GetListTextFileUrl(const GURL sub_url) const;
 
   std::vector<SubscriptionInfo> GetSubscriptions();
+  // Returns the cached list text files of all enabled subscriptions. Files for
+  // subscriptions that have not been downloaded yet may not exist.
+  std::vector<std::pair<GURL, base::FilePath>> GetEnabledListFiles();
   void EnableSubscription(const GURL& sub_url, bool enabled);
   void DeleteSubscription(const GURL& sub_url);
   void RefreshSubscription(const GURL& sub_url, bool from_ui);
@@ -69,8 +73,9 @@ class AdBlockSubscriptionServiceManager {
   void EnableTag(const std::string& tag, bool enabled);
   void AddResources(const std::string& resources);
 
-  absl::optional<base::Value> UrlCosmeticResources(const std::string& url);
-  absl::optional<base::Value> HiddenClassIdSelectors(
+  absl::optional<adblock::UrlCosmeticResources> UrlCosmeticResources(
+      const std::string& url);
+  std::vector<std::string> HiddenClassIdSelectors(
       const std::vector<std::string>& classes,
       const std::vector<std::string>& ids,
       const std::vector<std::string>& exceptions);
@@ -105,6 +110,7 @@ class AdBlockSubscriptionServiceManager {
       AdBlockSubscriptionDownloadManager* download_manager);
 
   absl::optional<SubscriptionInfo> GetInfo(const GURL& sub_url);
+  void NotifyObserversOfListsChanged();
   void NotifyObserversOfServiceEvent();
 
   void SetUpdateIntervalsForTesting(base::TimeDelta* initial_delay,
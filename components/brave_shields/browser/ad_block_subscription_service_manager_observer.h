@@ -14,6 +14,10 @@ class AdBlockSubscriptionServiceManagerObserver : public base::CheckedObserver {
  public:
   ~AdBlockSubscriptionServiceManagerObserver() override {}
   virtual void OnServiceUpdateEvent() {}
+  // Called before OnServiceUpdateEvent() when the enabled lists or their
+  // contents changed, but not for metadata-only updates such as a failed
+  // download attempt.
+  virtual void OnSubscriptionListsChanged() {}
 };
 
 }  // namespace brave_shields
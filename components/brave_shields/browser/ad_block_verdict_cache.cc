@@ -0,0 +1,61 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/ad_block_verdict_cache.h"
+
+#include "base/strings/string_piece.h"
+#include "url/gurl.h"
+
+namespace brave_shields {
+
+AdBlockVerdictCache::AdBlockVerdictCache(size_t size_per_shard) {
+  for (auto& shard : shards_)
+    shard = std::make_unique<Shard>(size_per_shard);
+}
+
+AdBlockVerdictCache::~AdBlockVerdictCache() = default;
+
+// static
+AdBlockVerdictCache::Key AdBlockVerdictCache::MakeKey(
+    const GURL& url,
+    blink::mojom::ResourceType resource_type,
+    const std::string& tab_host,
+    bool aggressive_blocking) {
+  // Note that the key uses the full tab host rather than its eTLD+1, since
+  // $domain= options can target individual subdomains.
+  const std::string& spec = url.possibly_invalid_spec();
+  return Key{tab_host, spec, base::StringPieceHash()(spec), resource_type,
+             aggressive_blocking};
+}
+
+bool AdBlockVerdictCache::Get(const Key& key,
+                              uint64_t generation,
+                              AdBlockVerdict* verdict) {
+  Shard* shard = GetShard(key);
+  base::AutoLock lock(shard->lock);
+  auto it = shard->entries.Get(key);
+  if (it == shard->entries.end())
+    return false;
+  if (it->second.generation != generation) {
+    shard->entries.Erase(it);
+    return false;
+  }
+  *verdict = it->second.verdict;
+  return true;
+}
+
+void AdBlockVerdictCache::Put(const Key& key,
+                              uint64_t generation,
+                              const AdBlockVerdict& verdict) {
+  Shard* shard = GetShard(key);
+  base::AutoLock lock(shard->lock);
+  shard->entries.Put(key, Entry{generation, verdict});
+}
+
+AdBlockVerdictCache::Shard* AdBlockVerdictCache::GetShard(const Key& key) {
+  return shards_[key.url_hash % kShardCount].get();
+}
+
+}  // namespace brave_shields
@@ -0,0 +1,94 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_VERDICT_CACHE_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_VERDICT_CACHE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <array>
+#include <memory>
+#include <string>
+#include <tuple>
+
+#include "base/containers/mru_cache.h"
+#include "base/synchronization/lock.h"
+#include "third_party/blink/public/mojom/loader/resource_load_info.mojom-shared.h"
+
+class GURL;
+
+namespace brave_shields {
+
+// The merged result of running a request through every adblock engine.
+struct AdBlockVerdict {
+  bool did_match_rule = false;
+  bool did_match_exception = false;
+  bool did_match_important = false;
+  std::string mock_data_url;
+};
+
+// Bounded cache of adblock verdicts, split into independently locked shards.
+// Entries are tagged with the engine generation they were computed for, so
+// any change to the set of engines or their rules, tags or resources makes
+// older entries unreachable without an explicit flush.
+class AdBlockVerdictCache {
+ public:
+  // |url_hash| only picks the shard and short-circuits most comparisons; the
+  // full |url_spec| is always compared, so a page cannot reuse the verdict of
+  // a different URL by crafting a hash collision.
+  struct Key {
+    std::string tab_host;
+    std::string url_spec;
+    uint64_t url_hash;
+    blink::mojom::ResourceType resource_type;
+    bool aggressive_blocking;
+
+    bool operator<(const Key& other) const {
+      return std::tie(url_hash, resource_type, aggressive_blocking, tab_host,
+                      url_spec) < std::tie(other.url_hash,
+                                           other.resource_type,
+                                           other.aggressive_blocking,
+                                           other.tab_host, other.url_spec);
+    }
+  };
+
+  static constexpr size_t kShardCount = 8;
+
+  explicit AdBlockVerdictCache(size_t size_per_shard = 128);
+  ~AdBlockVerdictCache();
+
+  AdBlockVerdictCache(const AdBlockVerdictCache&) = delete;
+  AdBlockVerdictCache& operator=(const AdBlockVerdictCache&) = delete;
+
+  static Key MakeKey(const GURL& url,
+                     blink::mojom::ResourceType resource_type,
+                     const std::string& tab_host,
+                     bool aggressive_blocking);
+
+  bool Get(const Key& key, uint64_t generation, AdBlockVerdict* verdict);
+  void Put(const Key& key, uint64_t generation, const AdBlockVerdict& verdict);
+
+ private:
+  struct Entry {
+    uint64_t generation;
+    AdBlockVerdict verdict;
+  };
+
+  struct Shard {
+    explicit Shard(size_t size) : entries(size) {}
+
+    base::Lock lock;
+    base::MRUCache<Key, Entry> entries;
+  };
+
+  Shard* GetShard(const Key& key);
+
+  std::array<std::unique_ptr<Shard>, kShardCount> shards_;
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_VERDICT_CACHE_H_
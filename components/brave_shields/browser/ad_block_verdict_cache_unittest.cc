@@ -0,0 +1,116 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/ad_block_verdict_cache.h"
+
+#include <string>
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace brave_shields {
+
+TEST(AdBlockVerdictCacheTest, GetAndPut) {
+  AdBlockVerdictCache cache;
+  const auto key = AdBlockVerdictCache::MakeKey(
+      GURL("https://tracker.example/pixel.gif"),
+      blink::mojom::ResourceType::kImage, "brave.com", false);
+
+  AdBlockVerdict verdict;
+  EXPECT_FALSE(cache.Get(key, 1, &verdict));
+
+  AdBlockVerdict blocked;
+  blocked.did_match_rule = true;
+  blocked.mock_data_url = "data:image/gif;base64,R0lGODlhAQABAAAAACw=";
+  cache.Put(key, 1, blocked);
+
+  ASSERT_TRUE(cache.Get(key, 1, &verdict));
+  EXPECT_TRUE(verdict.did_match_rule);
+  EXPECT_FALSE(verdict.did_match_exception);
+  EXPECT_FALSE(verdict.did_match_important);
+  EXPECT_EQ(blocked.mock_data_url, verdict.mock_data_url);
+}
+
+TEST(AdBlockVerdictCacheTest, KeyDistinguishesRequestContext) {
+  AdBlockVerdictCache cache;
+  const GURL url("https://tracker.example/script.js");
+  AdBlockVerdict blocked;
+  blocked.did_match_rule = true;
+  cache.Put(AdBlockVerdictCache::MakeKey(
+                url, blink::mojom::ResourceType::kScript, "brave.com", false),
+            1, blocked);
+
+  AdBlockVerdict verdict;
+  EXPECT_FALSE(cache.Get(
+      AdBlockVerdictCache::MakeKey(url, blink::mojom::ResourceType::kImage,
+                                   "brave.com", false),
+      1, &verdict));
+  EXPECT_FALSE(cache.Get(
+      AdBlockVerdictCache::MakeKey(url, blink::mojom::ResourceType::kScript,
+                                   "sub.brave.com", false),
+      1, &verdict));
+  EXPECT_FALSE(cache.Get(
+      AdBlockVerdictCache::MakeKey(url, blink::mojom::ResourceType::kScript,
+                                   "brave.com", true),
+      1, &verdict));
+}
+
+TEST(AdBlockVerdictCacheTest, HashCollisionDoesNotShareVerdict) {
+  AdBlockVerdictCache cache;
+  auto allowed_key = AdBlockVerdictCache::MakeKey(
+      GURL("https://cdn.example/app.js"), blink::mojom::ResourceType::kScript,
+      "brave.com", false);
+  AdBlockVerdict allowed;
+  cache.Put(allowed_key, 1, allowed);
+
+  // Simulate a URL whose hash collides with the cached one.
+  auto colliding_key = AdBlockVerdictCache::MakeKey(
+      GURL("https://tracker.example/ads.js"),
+      blink::mojom::ResourceType::kScript, "brave.com", false);
+  colliding_key.url_hash = allowed_key.url_hash;
+
+  AdBlockVerdict verdict;
+  EXPECT_FALSE(cache.Get(colliding_key, 1, &verdict));
+  EXPECT_TRUE(cache.Get(allowed_key, 1, &verdict));
+}
+
+TEST(AdBlockVerdictCacheTest, StaleGenerationIsDropped) {
+  AdBlockVerdictCache cache;
+  const auto key = AdBlockVerdictCache::MakeKey(
+      GURL("https://tracker.example/pixel.gif"),
+      blink::mojom::ResourceType::kImage, "brave.com", false);
+  AdBlockVerdict blocked;
+  blocked.did_match_rule = true;
+  cache.Put(key, 1, blocked);
+
+  AdBlockVerdict verdict;
+  EXPECT_FALSE(cache.Get(key, 2, &verdict));
+  // The stale entry is evicted, so the old generation no longer matches.
+  EXPECT_FALSE(cache.Get(key, 1, &verdict));
+}
+
+TEST(AdBlockVerdictCacheTest, ShardsAreBounded) {
+  AdBlockVerdictCache cache(1);
+  AdBlockVerdict verdict;
+  for (int i = 0; i < 100; ++i) {
+    cache.Put(AdBlockVerdictCache::MakeKey(
+                  GURL("https://tracker.example/" + std::to_string(i)),
+                  blink::mojom::ResourceType::kImage, "brave.com", false),
+              1, verdict);
+  }
+
+  size_t hits = 0;
+  for (int i = 0; i < 100; ++i) {
+    if (cache.Get(AdBlockVerdictCache::MakeKey(
+                      GURL("https://tracker.example/" + std::to_string(i)),
+                      blink::mojom::ResourceType::kImage, "brave.com", false),
+                  1, &verdict)) {
+      ++hits;
+    }
+  }
+  EXPECT_LE(hits, AdBlockVerdictCache::kShardCount);
+}
+
+}  // namespace brave_shields
@@ -3,7 +3,10 @@
  * License, v. 2.0. If a copy of the MPL was not distributed with this file,
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
-#include "base/json/json_reader.h"
+#include <string>
+#include <utility>
+#include <vector>
+
 #include "brave/components/brave_shields/browser/ad_block_service_helper.h"
 #include "testing/gmock/include/gmock/gmock.h"
 #include "testing/gtest/include/gtest/gtest.h"
@@ -17,24 +20,18 @@ class CosmeticResourceMergeTest : public testing::Test {
   CosmeticResourceMergeTest() {}
   ~CosmeticResourceMergeTest() override {}
 
-  void CompareMergeFromStrings(
-          const std::string& a,
-          const std::string& b,
-          bool force_hide,
-          const std::string& expected) {
-    absl::optional<base::Value> a_val = base::JSONReader::Read(a);
-    ASSERT_TRUE(a_val);
-
-    absl::optional<base::Value> b_val = base::JSONReader::Read(b);
-    ASSERT_TRUE(b_val);
-
-    const absl::optional<base::Value> expected_val =
-        base::JSONReader::Read(expected);
-    ASSERT_TRUE(expected_val);
-
-    MergeResourcesInto(std::move(b_val.value()), &*a_val, force_hide);
-
-    ASSERT_EQ(*a_val, *expected_val);
+  void CompareMerge(adblock::UrlCosmeticResources a,
+                    adblock::UrlCosmeticResources b,
+                    bool force_hide,
+                    const adblock::UrlCosmeticResources& expected) {
+    MergeResourcesInto(std::move(b), &a, force_hide);
+
+    EXPECT_EQ(a.hide_selectors, expected.hide_selectors);
+    EXPECT_EQ(a.force_hide_selectors, expected.force_hide_selectors);
+    EXPECT_EQ(a.style_selectors, expected.style_selectors);
+    EXPECT_EQ(a.exceptions, expected.exceptions);
+    EXPECT_EQ(a.injected_script, expected.injected_script);
+    EXPECT_EQ(a.generichide, expected.generichide);
   }
 
  protected:
@@ -43,268 +40,149 @@ class CosmeticResourceMergeTest : public testing::Test {
   void TearDown() override {}
 };
 
-const char EMPTY_RESOURCES[] = "{"
-    "\"hide_selectors\": [], "
-    "\"style_selectors\": {}, "
-    "\"exceptions\": [], "
-    "\"injected_script\": \"\", "
-    "\"generichide\": false"
-"}";
-
-const char NONEMPTY_RESOURCES[] = "{"
-    "\"hide_selectors\": [\"a\", \"b\"], "
-    "\"style_selectors\": {"
-        "\"c\": [\"color: #fff\"], "
-        "\"d\": [\"color: #000\"]"
-    "}, "
-    "\"exceptions\": [\"e\", \"f\"], "
-    "\"injected_script\": \"console.log('g')\", "
-    "\"generichide\": false"
-"}";
+adblock::UrlCosmeticResources EmptyResources() {
+  return adblock::UrlCosmeticResources();
+}
+
+adblock::UrlCosmeticResources NonEmptyResources() {
+  adblock::UrlCosmeticResources resources;
+  resources.hide_selectors = {"a", "b"};
+  resources.style_selectors = {{"c", {"color: #fff"}}, {"d", {"color: #000"}}};
+  resources.exceptions = {"e", "f"};
+  resources.injected_script = "console.log('g')";
+  return resources;
+}
 
-TEST_F(CosmeticResourceMergeTest, MergeTwoEmptyResources) {
-  const std::string a = EMPTY_RESOURCES;
-  const std::string b = EMPTY_RESOURCES;
+adblock::UrlCosmeticResources OtherNonEmptyResources() {
+  adblock::UrlCosmeticResources resources;
+  resources.hide_selectors = {"h", "i"};
+  resources.style_selectors = {{"j", {"color: #eee"}}, {"k", {"color: #111"}}};
+  resources.exceptions = {"l", "m"};
+  resources.injected_script = "console.log('n')";
+  return resources;
+}
 
-  // Same as EMPTY_RESOURCES, but with an additional newline in the
+TEST_F(CosmeticResourceMergeTest, MergeTwoEmptyResources) {
+  // Same as EmptyResources(), but with an additional newline in the
   // injected_script
-  const std::string expected = "{"
-      "\"hide_selectors\": [], "
-      "\"style_selectors\": {}, "
-      "\"exceptions\": [], "
-      "\"injected_script\": \"\n\", "
-      "\"generichide\": false"
-  "}";
-
-  CompareMergeFromStrings(a, b, false, expected);
+  adblock::UrlCosmeticResources expected;
+  expected.injected_script = "\n";
+
+  CompareMerge(EmptyResources(), EmptyResources(), false, expected);
 }
 
 TEST_F(CosmeticResourceMergeTest, MergeEmptyIntoNonEmpty) {
-  const std::string a = NONEMPTY_RESOURCES;
-  const std::string b = EMPTY_RESOURCES;
-
   // Same as a, but with an additional newline at the end of the
   // injected_script
-  const std::string expected = "{"
-      "\"hide_selectors\": [\"a\", \"b\"], "
-      "\"style_selectors\": {"
-          "\"c\": [\"color: #fff\"], "
-          "\"d\": [\"color: #000\"]"
-      "}, "
-      "\"exceptions\": [\"e\", \"f\"], "
-      "\"injected_script\": \"console.log('g')\n\", "
-      "\"generichide\": false"
-  "}";
-
-  CompareMergeFromStrings(a, b, false, expected);
+  adblock::UrlCosmeticResources expected = NonEmptyResources();
+  expected.injected_script = "console.log('g')\n";
+
+  CompareMerge(NonEmptyResources(), EmptyResources(), false, expected);
 }
 
 TEST_F(CosmeticResourceMergeTest, MergeNonEmptyIntoEmpty) {
-  const std::string a = EMPTY_RESOURCES;
-  const std::string b = NONEMPTY_RESOURCES;
-
   // Same as b, but with an additional newline at the beginning of the
   // injected_script
-  const std::string expected = "{"
-      "\"hide_selectors\": [\"a\", \"b\"],"
-      "\"style_selectors\": {"
-          "\"c\": [\"color: #fff\"], "
-          "\"d\": [\"color: #000\"]"
-      "}, "
-      "\"exceptions\": [\"e\", \"f\"], "
-      "\"injected_script\": \"\nconsole.log('g')\", "
-      "\"generichide\": false"
-  "}";
-
-  CompareMergeFromStrings(a, b, false, expected);
+  adblock::UrlCosmeticResources expected = NonEmptyResources();
+  expected.injected_script = "\nconsole.log('g')";
+
+  CompareMerge(EmptyResources(), NonEmptyResources(), false, expected);
 }
 
 TEST_F(CosmeticResourceMergeTest, MergeNonEmptyIntoNonEmpty) {
-  const std::string a = NONEMPTY_RESOURCES;
-  const std::string b = "{"
-      "\"hide_selectors\": [\"h\", \"i\"], "
-      "\"style_selectors\": {"
-          "\"j\": [\"color: #eee\"], "
-          "\"k\": [\"color: #111\"]"
-      "}, "
-      "\"exceptions\": [\"l\", \"m\"], "
-      "\"injected_script\": \"console.log('n')\", "
-      "\"generichide\": false"
-  "}";
-
-  const std::string expected = "{"
-      "\"hide_selectors\": [\"a\", \"b\", \"h\", \"i\"], "
-      "\"style_selectors\": {"
-          "\"c\": [\"color: #fff\"], "
-          "\"d\": [\"color: #000\"], "
-          "\"j\": [\"color: #eee\"], "
-          "\"k\": [\"color: #111\"]"
-      "}, "
-      "\"exceptions\": [\"e\", \"f\", \"l\", \"m\"], "
-      "\"injected_script\": \"console.log('g')\nconsole.log('n')\", "
-      "\"generichide\": false"
-  "}";
-
-  CompareMergeFromStrings(a, b, false, expected);
+  adblock::UrlCosmeticResources expected;
+  expected.hide_selectors = {"a", "b", "h", "i"};
+  expected.style_selectors = {{"c", {"color: #fff"}},
+                              {"d", {"color: #000"}},
+                              {"j", {"color: #eee"}},
+                              {"k", {"color: #111"}}};
+  expected.exceptions = {"e", "f", "l", "m"};
+  expected.injected_script = "console.log('g')\nconsole.log('n')";
+
+  CompareMerge(NonEmptyResources(), OtherNonEmptyResources(), false, expected);
 }
 
 TEST_F(CosmeticResourceMergeTest, MergeEmptyForceHide) {
-  const std::string a = EMPTY_RESOURCES;
-  const std::string b = EMPTY_RESOURCES;
-
-  // Same as EMPTY_RESOURCES, but with an additional newline in the
-  // injected_script and a new empty `force_hide_selectors` array
-  const std::string expected = "{"
-      "\"hide_selectors\": [], "
-      "\"style_selectors\": {}, "
-      "\"exceptions\": [], "
-      "\"injected_script\": \"\n\","
-      "\"generichide\": false, "
-      "\"force_hide_selectors\": []"
-  "}";
-
-  CompareMergeFromStrings(a, b, true, expected);
+  // Same as EmptyResources(), but with an additional newline in the
+  // injected_script
+  adblock::UrlCosmeticResources expected;
+  expected.injected_script = "\n";
+
+  CompareMerge(EmptyResources(), EmptyResources(), true, expected);
 }
 
 TEST_F(CosmeticResourceMergeTest, MergeNonEmptyForceHide) {
-  const std::string a = NONEMPTY_RESOURCES;
-  const std::string b = "{"
-      "\"hide_selectors\": [\"h\", \"i\"], "
-      "\"style_selectors\": {"
-          "\"j\": [\"color: #eee\"], "
-          "\"k\": [\"color: #111\"]"
-      "}, "
-      "\"exceptions\": [\"l\", \"m\"], "
-      "\"injected_script\": \"console.log('n')\", "
-      "\"generichide\": false"
-  "}";
-
-  const std::string expected = "{"
-      "\"hide_selectors\": [\"a\", \"b\"], "
-      "\"style_selectors\": {"
-          "\"c\": [\"color: #fff\"], "
-          "\"d\": [\"color: #000\"], "
-          "\"j\": [\"color: #eee\"], "
-          "\"k\": [\"color: #111\"]"
-      "}, "
-      "\"exceptions\": [\"e\", \"f\", \"l\", \"m\"], "
-      "\"injected_script\": \"console.log('g')\nconsole.log('n')\","
-      "\"generichide\": false, "
-      "\"force_hide_selectors\": [\"h\", \"i\"]"
-  "}";
-
-  CompareMergeFromStrings(a, b, true, expected);
+  adblock::UrlCosmeticResources expected;
+  expected.hide_selectors = {"a", "b"};
+  expected.force_hide_selectors = {"h", "i"};
+  expected.style_selectors = {{"c", {"color: #fff"}},
+                              {"d", {"color: #000"}},
+                              {"j", {"color: #eee"}},
+                              {"k", {"color: #111"}}};
+  expected.exceptions = {"e", "f", "l", "m"};
+  expected.injected_script = "console.log('g')\nconsole.log('n')";
+
+  CompareMerge(NonEmptyResources(), OtherNonEmptyResources(), true, expected);
 }
 
 TEST_F(CosmeticResourceMergeTest, MergeNonGenerichideIntoGenerichide) {
-  const std::string a = "{"
-      "\"hide_selectors\": [], "
-      "\"style_selectors\": {}, "
-      "\"exceptions\": [], "
-      "\"injected_script\": \"\n\", "
-      "\"generichide\": true"
-  "}";
-  const std::string b = EMPTY_RESOURCES;
-
-  const std::string expected = "{"
-      "\"hide_selectors\": [], "
-      "\"style_selectors\": {}, "
-      "\"exceptions\": [], "
-      "\"injected_script\": \"\n\n\", "
-      "\"generichide\": true"
-  "}";
-
-  CompareMergeFromStrings(a, b, false, expected);
+  adblock::UrlCosmeticResources a;
+  a.injected_script = "\n";
+  a.generichide = true;
+
+  adblock::UrlCosmeticResources expected;
+  expected.injected_script = "\n\n";
+  expected.generichide = true;
+
+  CompareMerge(a, EmptyResources(), false, expected);
 }
 
 TEST_F(CosmeticResourceMergeTest, MergeGenerichideIntoNonGenerichide) {
-  const std::string a = NONEMPTY_RESOURCES;
-  const std::string b = "{"
-      "\"hide_selectors\": [\"h\", \"i\"], "
-      "\"style_selectors\": {"
-          "\"j\": [\"color: #eee\"], "
-          "\"k\": [\"color: #111\"]"
-      "}, "
-      "\"exceptions\": [\"l\", \"m\"], "
-      "\"injected_script\": \"console.log('n')\", "
-      "\"generichide\": true"
-  "}";
-
-  const std::string expected = "{"
-      "\"hide_selectors\": [\"a\", \"b\", \"h\", \"i\"], "
-      "\"style_selectors\": {"
-          "\"c\": [\"color: #fff\"], "
-          "\"d\": [\"color: #000\"], "
-          "\"j\": [\"color: #eee\"], "
-          "\"k\": [\"color: #111\"]"
-      "}, "
-      "\"exceptions\": [\"e\", \"f\", \"l\", \"m\"], "
-      "\"injected_script\": \"console.log('g')\nconsole.log('n')\", "
-      "\"generichide\": true"
-  "}";
-
-  CompareMergeFromStrings(a, b, false, expected);
+  adblock::UrlCosmeticResources b = OtherNonEmptyResources();
+  b.generichide = true;
+
+  adblock::UrlCosmeticResources expected;
+  expected.hide_selectors = {"a", "b", "h", "i"};
+  expected.style_selectors = {{"c", {"color: #fff"}},
+                              {"d", {"color: #000"}},
+                              {"j", {"color: #eee"}},
+                              {"k", {"color: #111"}}};
+  expected.exceptions = {"e", "f", "l", "m"};
+  expected.injected_script = "console.log('g')\nconsole.log('n')";
+  expected.generichide = true;
+
+  CompareMerge(NonEmptyResources(), b, false, expected);
 }
 
 TEST_F(CosmeticResourceMergeTest, MergeGenerichideIntoGenerichide) {
-  const std::string a = "{"
-      "\"hide_selectors\": [], "
-      "\"style_selectors\": {}, "
-      "\"exceptions\": [], "
-      "\"injected_script\": \"\", "
-      "\"generichide\": true"
-  "}";
-
-  const std::string expected = "{"
-      "\"hide_selectors\": [], "
-      "\"style_selectors\": {}, "
-      "\"exceptions\": [], "
-      "\"injected_script\": \"\n\", "
-      "\"generichide\": true"
-  "}";
-
-  CompareMergeFromStrings(a, a, false, expected);
+  adblock::UrlCosmeticResources a;
+  a.generichide = true;
+
+  adblock::UrlCosmeticResources expected;
+  expected.injected_script = "\n";
+  expected.generichide = true;
+
+  CompareMerge(a, a, false, expected);
 }
 
 TEST_F(CosmeticResourceMergeTest, MergeStyles) {
-  const std::string a = "{"
-      "\"hide_selectors\": [], "
-      "\"style_selectors\": {"
-          "\".a\": [\"color: #eee\"], "
-          "\".b\": [\"color: #111\"], "
-          "\".d\": [\"padding: 0\"]"
-      "}, "
-      "\"exceptions\": [], "
-      "\"injected_script\": \"\", "
-      "\"generichide\": false"
-  "}";
-  const std::string b = "{"
-      "\"hide_selectors\": [], "
-      "\"style_selectors\": {"
-          "\".c\": [\"margin: 0\"], "
-          "\".b\": [\"background: #000\"], "
-          "\".a\": [\"background: #fff\"]"
-      "}, "
-      "\"exceptions\": [], "
-      "\"injected_script\": \"\", "
-      "\"generichide\": false"
-  "}";
-
-  const std::string expected = "{"
-      "\"hide_selectors\": [], "
-      "\"style_selectors\": {"
-          "\".a\": [\"color: #eee\", \"background: #fff\"], "
-          "\".b\": [\"color: #111\", \"background: #000\"], "
-          "\".c\": [\"margin: 0\"], "
-          "\".d\": [\"padding: 0\"] "
-      "}, "
-      "\"exceptions\": [], "
-      "\"injected_script\": \"\n\", "
-      "\"generichide\": false"
-  "}";
-
-  CompareMergeFromStrings(a, b, false, expected);
+  adblock::UrlCosmeticResources a;
+  a.style_selectors = {{".a", {"color: #eee"}},
+                       {".b", {"color: #111"}},
+                       {".d", {"padding: 0"}}};
+  adblock::UrlCosmeticResources b;
+  b.style_selectors = {{".c", {"margin: 0"}},
+                       {".b", {"background: #000"}},
+                       {".a", {"background: #fff"}}};
+
+  adblock::UrlCosmeticResources expected;
+  expected.style_selectors = {{".a", {"color: #eee", "background: #fff"}},
+                              {".b", {"color: #111", "background: #000"}},
+                              {".c", {"margin: 0"}},
+                              {".d", {"padding: 0"}}};
+  expected.injected_script = "\n";
+
+  CompareMerge(a, b, false, expected);
 }
 
-
 }  // namespace brave_shields
@@ -28,3 +28,22 @@ TEST(HTTPSEverywhereRecentlyUsedCacheTest, Operations) {
   cache.remove("kD");
   ASSERT_FALSE(cache.get("kD", &v));
 }
+
+TEST(HTTPSEverywhereRecentlyUsedCacheTest, Sharded) {
+  using Cache = HTTPSERecentlyUsedCache<bool>;
+  Cache cache(64, 4);
+
+  for (int i = 0; i < 16; ++i)
+    cache.add("host" + std::to_string(i), true);
+  bool v = false;
+  for (int i = 0; i < 16; ++i) {
+    ASSERT_TRUE(cache.get("host" + std::to_string(i), &v));
+    ASSERT_TRUE(v);
+  }
+
+  cache.remove("host0");
+  ASSERT_FALSE(cache.get("host0", &v));
+
+  cache.clear();
+  ASSERT_FALSE(cache.get("host1", &v));
+}
@@ -0,0 +1,127 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/https_everywhere_rules.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "base/json/json_reader.h"
+#include "base/values.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
+#include "third_party/re2/src/re2/re2.h"
+
+namespace brave_shields {
+
+HTTPSEverywhereRules::Rule::Rule() = default;
+HTTPSEverywhereRules::Rule::Rule(Rule&&) = default;
+HTTPSEverywhereRules::Rule& HTTPSEverywhereRules::Rule::operator=(Rule&&) =
+    default;
+HTTPSEverywhereRules::Rule::~Rule() = default;
+
+HTTPSEverywhereRules::Target::Target() = default;
+HTTPSEverywhereRules::Target::Target(Target&&) = default;
+HTTPSEverywhereRules::Target& HTTPSEverywhereRules::Target::operator=(
+    Target&&) = default;
+HTTPSEverywhereRules::Target::~Target() = default;
+
+HTTPSEverywhereRules::HTTPSEverywhereRules(std::vector<Target> targets)
+    : targets_(std::move(targets)) {}
+
+HTTPSEverywhereRules::~HTTPSEverywhereRules() = default;
+
+// static
+std::unique_ptr<HTTPSEverywhereRules> HTTPSEverywhereRules::FromJSON(
+    const std::string& json) {
+  absl::optional<base::Value> json_object = base::JSONReader::Read(json);
+  if (!json_object || !json_object->is_list())
+    return nullptr;
+
+  std::vector<Target> targets;
+  for (const base::Value& target_value : json_object->GetList()) {
+    if (!target_value.is_dict())
+      continue;
+
+    Target target;
+    const base::Value* exclusions = target_value.FindListKey("e");
+    if (exclusions) {
+      for (const base::Value& exclusion : exclusions->GetList()) {
+        if (!exclusion.is_dict())
+          continue;
+        const std::string* pattern = exclusion.FindStringKey("p");
+        if (!pattern)
+          continue;
+        auto re = CompilePattern(CorrectRuleForRE2(*pattern));
+        if (re)
+          target.exclusions.push_back(std::move(re));
+      }
+    }
+
+    const base::Value* rules = target_value.FindListKey("r");
+    target.has_rules = !!rules;
+    if (rules) {
+      for (const base::Value& rule_value : rules->GetList()) {
+        if (!rule_value.is_dict())
+          continue;
+        Rule rule;
+        if (rule_value.FindKey("d")) {
+          rule.is_default = true;
+        } else {
+          const std::string* from = rule_value.FindStringKey("f");
+          const std::string* to = rule_value.FindStringKey("t");
+          if (!from || !to)
+            continue;
+          rule.from = CompilePattern(*from);
+          if (!rule.from)
+            continue;
+          rule.to = CorrectRuleForRE2(*to);
+        }
+        target.rules.push_back(std::move(rule));
+      }
+    }
+    targets.push_back(std::move(target));
+  }
+  return std::make_unique<HTTPSEverywhereRules>(std::move(targets));
+}
+
+// static
+std::unique_ptr<re2::RE2> HTTPSEverywhereRules::CompilePattern(
+    const std::string& pattern) {
+  auto re = std::make_unique<re2::RE2>(pattern, re2::RE2::Quiet);
+  if (!re->ok())
+    return nullptr;
+  return re;
+}
+
+// static
+std::string HTTPSEverywhereRules::CorrectRuleForRE2(const std::string& rule) {
+  std::string corrected(rule);
+  std::replace(corrected.begin(), corrected.end(), '$', '\\');
+  return corrected;
+}
+
+std::string HTTPSEverywhereRules::Apply(const std::string& url) const {
+  for (const Target& target : targets_) {
+    for (const auto& exclusion : target.exclusions) {
+      if (re2::RE2::FullMatch(url, *exclusion))
+        return std::string();
+    }
+
+    if (!target.has_rules)
+      return std::string();
+
+    for (const Rule& rule : target.rules) {
+      std::string new_url(url);
+      if (rule.is_default)
+        return new_url.insert(4, "s");
+
+      if (re2::RE2::Replace(&new_url, *rule.from, rule.to) && new_url != url)
+        return new_url;
+    }
+  }
+  return std::string();
+}
+
+}  // namespace brave_shields
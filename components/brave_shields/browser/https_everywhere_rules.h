@@ -0,0 +1,74 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_RULES_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_RULES_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace re2 {
+class RE2;
+}  // namespace re2
+
+namespace brave_shields {
+
+// The HTTPS Everywhere rules stored for one lookup key, with every pattern
+// compiled, so they can be applied to many URLs.
+class HTTPSEverywhereRules {
+ public:
+  struct Rule {
+    Rule();
+    Rule(Rule&&);
+    Rule& operator=(Rule&&);
+    ~Rule();
+
+    // "d" rules upgrade the URL as is.
+    bool is_default = false;
+    std::unique_ptr<re2::RE2> from;
+    std::string to;
+  };
+
+  struct Target {
+    Target();
+    Target(Target&&);
+    Target& operator=(Target&&);
+    ~Target();
+
+    std::vector<std::unique_ptr<re2::RE2>> exclusions;
+    // False when the target had no "r" list, which stops the lookup.
+    bool has_rules = false;
+    std::vector<Rule> rules;
+  };
+
+  explicit HTTPSEverywhereRules(std::vector<Target> targets);
+  ~HTTPSEverywhereRules();
+
+  HTTPSEverywhereRules(const HTTPSEverywhereRules&) = delete;
+  HTTPSEverywhereRules& operator=(const HTTPSEverywhereRules&) = delete;
+
+  // Parses the JSON rule list stored in the LevelDB database. Returns nullptr
+  // if |json| is not a list.
+  static std::unique_ptr<HTTPSEverywhereRules> FromJSON(
+      const std::string& json);
+
+  // Compiles |pattern|, or returns nullptr if it is invalid. Invalid patterns
+  // never match, so callers drop them.
+  static std::unique_ptr<re2::RE2> CompilePattern(const std::string& pattern);
+
+  // HTTPS Everywhere rules use `$1` style back references, RE2 wants `\1`.
+  static std::string CorrectRuleForRE2(const std::string& rule);
+
+  // Returns the rewritten |url|, or an empty string if no rule applies.
+  std::string Apply(const std::string& url) const;
+
+ private:
+  std::vector<Target> targets_;
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_RULES_H_
@@ -0,0 +1,337 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/https_everywhere_ruleset.h"
+
+#include <string.h>
+
+#include <utility>
+
+#include "base/files/file_path.h"
+#include "base/files/memory_mapped_file.h"
+#include "base/hash/hash.h"
+#include "base/json/json_reader.h"
+#include "base/logging.h"
+#include "base/numerics/checked_math.h"
+#include "base/values.h"
+#include "brave/components/brave_shields/browser/https_everywhere_rules.h"
+#include "build/build_config.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
+
+#if !defined(ARCH_CPU_LITTLE_ENDIAN)
+#error "The HTTPS Everywhere ruleset format assumes a little-endian host."
+#endif
+
+namespace brave_shields {
+
+namespace {
+
+template <typename T>
+bool TakeSpan(base::span<const uint8_t>* data,
+              uint32_t count,
+              base::span<const T>* out) {
+  base::CheckedNumeric<size_t> size = count;
+  size *= sizeof(T);
+  if (!size.IsValid() || size.ValueOrDie() > data->size())
+    return false;
+  *out = base::make_span(reinterpret_cast<const T*>(data->data()), count);
+  *data = data->subspan(size.ValueOrDie());
+  return true;
+}
+
+template <typename T>
+void AppendStruct(const T& value, std::vector<uint8_t>* out) {
+  const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+  out->insert(out->end(), bytes, bytes + sizeof(T));
+}
+
+template <typename T>
+void AppendVector(const std::vector<T>& values, std::vector<uint8_t>* out) {
+  for (const auto& value : values)
+    AppendStruct(value, out);
+}
+
+}  // namespace
+
+constexpr char HTTPSEverywhereRuleset::kMagic[4];
+
+HTTPSEverywhereRuleset::HTTPSEverywhereRuleset() = default;
+
+HTTPSEverywhereRuleset::~HTTPSEverywhereRuleset() = default;
+
+// static
+std::unique_ptr<HTTPSEverywhereRuleset> HTTPSEverywhereRuleset::Load(
+    const base::FilePath& path) {
+  auto mapped_file = std::make_unique<base::MemoryMappedFile>();
+  if (!mapped_file->Initialize(path))
+    return nullptr;
+
+  std::unique_ptr<HTTPSEverywhereRuleset> ruleset(new HTTPSEverywhereRuleset());
+  if (!ruleset->Init(base::make_span(mapped_file->data(),
+                                     mapped_file->length()))) {
+    LOG(ERROR) << "Malformed HTTPS Everywhere ruleset " << path;
+    return nullptr;
+  }
+  ruleset->mapped_file_ = std::move(mapped_file);
+  return ruleset;
+}
+
+// static
+std::unique_ptr<HTTPSEverywhereRuleset>
+HTTPSEverywhereRuleset::CreateFromBuffer(std::vector<uint8_t> buffer) {
+  std::unique_ptr<HTTPSEverywhereRuleset> ruleset(new HTTPSEverywhereRuleset());
+  ruleset->buffer_ = std::move(buffer);
+  if (!ruleset->Init(ruleset->buffer_))
+    return nullptr;
+  return ruleset;
+}
+
+// static
+uint32_t HTTPSEverywhereRuleset::Hash(base::StringPiece key) {
+  return base::PersistentHash(base::as_bytes(base::make_span(key)));
+}
+
+bool HTTPSEverywhereRuleset::Init(base::span<const uint8_t> data) {
+  if (data.size() < sizeof(Header) ||
+      reinterpret_cast<uintptr_t>(data.data()) % alignof(Header) != 0) {
+    return false;
+  }
+  header_ = reinterpret_cast<const Header*>(data.data());
+  if (memcmp(header_->magic, kMagic, sizeof(kMagic)) != 0 ||
+      header_->version != kVersion || header_->bucket_count == 0 ||
+      (header_->bucket_count & (header_->bucket_count - 1)) != 0) {
+    return false;
+  }
+  data = data.subspan(sizeof(Header));
+
+  if (!TakeSpan(&data, header_->bucket_count, &buckets_) ||
+      !TakeSpan(&data, header_->host_count, &hosts_) ||
+      !TakeSpan(&data, header_->rule_set_count, &rule_sets_) ||
+      !TakeSpan(&data, header_->target_count, &targets_) ||
+      !TakeSpan(&data, header_->exclusion_count, &exclusions_) ||
+      !TakeSpan(&data, header_->rule_count, &rules_) ||
+      data.size() != header_->strings_size) {
+    return false;
+  }
+  strings_ =
+      base::StringPiece(reinterpret_cast<const char*>(data.data()), data.size());
+  return true;
+}
+
+base::StringPiece HTTPSEverywhereRuleset::GetString(
+    const StringRef& ref) const {
+  if (ref.offset > strings_.size() ||
+      ref.length > strings_.size() - ref.offset) {
+    return base::StringPiece();
+  }
+  return strings_.substr(ref.offset, ref.length);
+}
+
+const HTTPSEverywhereRuleset::HostEntry* HTTPSEverywhereRuleset::FindHost(
+    base::StringPiece lookup_key) const {
+  const uint32_t hash = Hash(lookup_key);
+  const uint32_t mask = header_->bucket_count - 1;
+  for (uint32_t i = 0, bucket = hash & mask; i < header_->bucket_count;
+       ++i, bucket = (bucket + 1) & mask) {
+    const uint32_t slot = buckets_[bucket];
+    if (slot == 0 || slot > hosts_.size())
+      return nullptr;
+    const HostEntry& host = hosts_[slot - 1];
+    if (host.hash == hash && GetString(host.key) == lookup_key)
+      return host.rule_set < rule_sets_.size() ? &host : nullptr;
+  }
+  return nullptr;
+}
+
+bool HTTPSEverywhereRuleset::HasRules(base::StringPiece lookup_key) const {
+  return FindHost(lookup_key) != nullptr;
+}
+
+std::unique_ptr<HTTPSEverywhereRules> HTTPSEverywhereRuleset::GetRules(
+    base::StringPiece lookup_key) const {
+  const HostEntry* host = FindHost(lookup_key);
+  if (!host)
+    return nullptr;
+
+  std::vector<HTTPSEverywhereRules::Target> targets;
+  const RuleSetEntry& rule_set = rule_sets_[host->rule_set];
+  if (rule_set.first_target > targets_.size() ||
+      rule_set.target_count > targets_.size() - rule_set.first_target) {
+    return std::make_unique<HTTPSEverywhereRules>(std::move(targets));
+  }
+
+  for (const TargetEntry& target : targets_.subspan(rule_set.first_target,
+                                                    rule_set.target_count)) {
+    HTTPSEverywhereRules::Target compiled_target;
+    if (target.first_exclusion <= exclusions_.size() &&
+        target.exclusion_count <=
+            exclusions_.size() - target.first_exclusion) {
+      for (const StringRef& exclusion : exclusions_.subspan(
+               target.first_exclusion, target.exclusion_count)) {
+        auto re = HTTPSEverywhereRules::CompilePattern(
+            std::string(GetString(exclusion)));
+        if (re)
+          compiled_target.exclusions.push_back(std::move(re));
+      }
+    }
+
+    compiled_target.has_rules =
+        target.rule_count != kNoRules && target.first_rule <= rules_.size() &&
+        target.rule_count <= rules_.size() - target.first_rule;
+    if (compiled_target.has_rules) {
+      for (const RuleEntry& rule :
+           rules_.subspan(target.first_rule, target.rule_count)) {
+        HTTPSEverywhereRules::Rule compiled_rule;
+        compiled_rule.is_default = rule.is_default != 0;
+        if (!compiled_rule.is_default) {
+          compiled_rule.from = HTTPSEverywhereRules::CompilePattern(
+              std::string(GetString(rule.from)));
+          if (!compiled_rule.from)
+            continue;
+          compiled_rule.to = std::string(GetString(rule.to));
+        }
+        compiled_target.rules.push_back(std::move(compiled_rule));
+      }
+    }
+    targets.push_back(std::move(compiled_target));
+  }
+  return std::make_unique<HTTPSEverywhereRules>(std::move(targets));
+}
+
+std::string HTTPSEverywhereRuleset::ApplyRules(base::StringPiece lookup_key,
+                                               const std::string& url) const {
+  std::unique_ptr<HTTPSEverywhereRules> rules = GetRules(lookup_key);
+  return rules ? rules->Apply(url) : std::string();
+}
+
+HTTPSEverywhereRulesetBuilder::HTTPSEverywhereRulesetBuilder() = default;
+
+HTTPSEverywhereRulesetBuilder::~HTTPSEverywhereRulesetBuilder() = default;
+
+bool HTTPSEverywhereRulesetBuilder::AddHost(const std::string& lookup_key,
+                                            const std::string& rules_json) {
+  absl::optional<base::Value> json_object = base::JSONReader::Read(rules_json);
+  if (!json_object || !json_object->is_list())
+    return false;
+
+  HTTPSEverywhereRuleset::RuleSetEntry rule_set;
+  rule_set.first_target = targets_.size();
+  rule_set.target_count = 0;
+
+  for (const base::Value& target_value : json_object->GetList()) {
+    if (!target_value.is_dict())
+      continue;
+
+    HTTPSEverywhereRuleset::TargetEntry target;
+    target.first_exclusion = exclusions_.size();
+    target.exclusion_count = 0;
+    const base::Value* exclusions = target_value.FindListKey("e");
+    if (exclusions) {
+      for (const base::Value& exclusion : exclusions->GetList()) {
+        if (!exclusion.is_dict())
+          continue;
+        const std::string* pattern = exclusion.FindStringKey("p");
+        if (!pattern)
+          continue;
+        exclusions_.push_back(
+            AddStringRef(HTTPSEverywhereRules::CorrectRuleForRE2(*pattern)));
+        target.exclusion_count++;
+      }
+    }
+
+    target.first_rule = rules_.size();
+    target.rule_count = 0;
+    const base::Value* rules = target_value.FindListKey("r");
+    if (!rules) {
+      target.rule_count = HTTPSEverywhereRuleset::kNoRules;
+    } else {
+      for (const base::Value& rule : rules->GetList()) {
+        if (!rule.is_dict())
+          continue;
+        HTTPSEverywhereRuleset::RuleEntry entry = {};
+        if (rule.FindKey("d")) {
+          entry.is_default = 1;
+        } else {
+          const std::string* from = rule.FindStringKey("f");
+          const std::string* to = rule.FindStringKey("t");
+          if (!from || !to)
+            continue;
+          entry.from = AddStringRef(*from);
+          entry.to =
+              AddStringRef(HTTPSEverywhereRules::CorrectRuleForRE2(*to));
+        }
+        rules_.push_back(entry);
+        target.rule_count++;
+      }
+    }
+
+    targets_.push_back(target);
+    rule_set.target_count++;
+  }
+
+  hosts_.emplace_back(lookup_key, rule_sets_.size());
+  rule_sets_.push_back(rule_set);
+  return true;
+}
+
+uint32_t HTTPSEverywhereRulesetBuilder::AddString(const std::string& value) {
+  const uint32_t offset = strings_.size();
+  strings_.append(value);
+  return offset;
+}
+
+HTTPSEverywhereRuleset::StringRef HTTPSEverywhereRulesetBuilder::AddStringRef(
+    const std::string& value) {
+  return {AddString(value), static_cast<uint32_t>(value.size())};
+}
+
+std::vector<uint8_t> HTTPSEverywhereRulesetBuilder::Build() const {
+  // Keep the table at most half full so probe sequences stay short.
+  uint32_t bucket_count = 16;
+  while (bucket_count < hosts_.size() * 2)
+    bucket_count *= 2;
+
+  std::string strings = strings_;
+  std::vector<HTTPSEverywhereRuleset::HostEntry> hosts;
+  std::vector<uint32_t> buckets(bucket_count, 0);
+  for (const auto& host : hosts_) {
+    HTTPSEverywhereRuleset::HostEntry entry;
+    entry.hash = HTTPSEverywhereRuleset::Hash(host.first);
+    entry.key = {static_cast<uint32_t>(strings.size()),
+                 static_cast<uint32_t>(host.first.size())};
+    entry.rule_set = host.second;
+    strings.append(host.first);
+    hosts.push_back(entry);
+
+    uint32_t bucket = entry.hash & (bucket_count - 1);
+    while (buckets[bucket] != 0)
+      bucket = (bucket + 1) & (bucket_count - 1);
+    buckets[bucket] = hosts.size();
+  }
+
+  HTTPSEverywhereRuleset::Header header;
+  memcpy(header.magic, HTTPSEverywhereRuleset::kMagic, sizeof(header.magic));
+  header.version = HTTPSEverywhereRuleset::kVersion;
+  header.bucket_count = bucket_count;
+  header.host_count = hosts.size();
+  header.rule_set_count = rule_sets_.size();
+  header.target_count = targets_.size();
+  header.exclusion_count = exclusions_.size();
+  header.rule_count = rules_.size();
+  header.strings_size = strings.size();
+
+  std::vector<uint8_t> result;
+  AppendStruct(header, &result);
+  AppendVector(buckets, &result);
+  AppendVector(hosts, &result);
+  AppendVector(rule_sets_, &result);
+  AppendVector(targets_, &result);
+  AppendVector(exclusions_, &result);
+  AppendVector(rules_, &result);
+  result.insert(result.end(), strings.begin(), strings.end());
+  return result;
+}
+
+}  // namespace brave_shields
@@ -0,0 +1,178 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_RULESET_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_RULESET_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/containers/span.h"
+#include "base/strings/string_piece.h"
+
+namespace base {
+class FilePath;
+class MemoryMappedFile;
+}  // namespace base
+
+namespace brave_shields {
+
+class HTTPSEverywhereRules;
+
+// Precompiled HTTPS Everywhere rules, laid out so they can be memory mapped
+// and queried in place.
+//
+// The file maps the same reversed-label lookup keys used by the LevelDB
+// database ("com.example", "com.example.*") through an open addressing hash
+// table to rule sets. Each lookup level of the reversed-label trie is a single
+// probe. Rule sets are stored already parsed, with the `$n` back references
+// rewritten to RE2 syntax, so a hit needs neither JSON parsing nor fix-ups.
+// Compiling the patterns is left to the caller, see GetRules().
+// All integers are little-endian uint32_t.
+//
+//   Header
+//   uint32_t buckets[bucket_count]      host index + 1, or 0 if empty
+//   HostEntry hosts[host_count]
+//   RuleSetEntry rule_sets[rule_set_count]
+//   TargetEntry targets[target_count]
+//   StringRef exclusions[exclusion_count]
+//   RuleEntry rules[rule_count]
+//   char strings[strings_size]
+class HTTPSEverywhereRuleset {
+ public:
+  static constexpr char kMagic[4] = {'H', 'S', 'E', 'R'};
+  static constexpr uint32_t kVersion = 1;
+
+  struct StringRef {
+    uint32_t offset;
+    uint32_t length;
+  };
+
+  struct Header {
+    char magic[4];
+    uint32_t version;
+    uint32_t bucket_count;
+    uint32_t host_count;
+    uint32_t rule_set_count;
+    uint32_t target_count;
+    uint32_t exclusion_count;
+    uint32_t rule_count;
+    uint32_t strings_size;
+  };
+
+  struct HostEntry {
+    uint32_t hash;
+    StringRef key;
+    uint32_t rule_set;
+  };
+
+  struct RuleSetEntry {
+    uint32_t first_target;
+    uint32_t target_count;
+  };
+
+  // One ruleset target from the original JSON list. |rule_count| is
+  // kNoRules when the entry had no "r" list, which stops the lookup.
+  struct TargetEntry {
+    uint32_t first_exclusion;
+    uint32_t exclusion_count;
+    uint32_t first_rule;
+    uint32_t rule_count;
+  };
+  static constexpr uint32_t kNoRules = 0xffffffff;
+
+  struct RuleEntry {
+    // Non-zero for "d" rules, which upgrade the URL as is.
+    uint32_t is_default;
+    StringRef from;
+    StringRef to;
+  };
+
+  ~HTTPSEverywhereRuleset();
+
+  HTTPSEverywhereRuleset(const HTTPSEverywhereRuleset&) = delete;
+  HTTPSEverywhereRuleset& operator=(const HTTPSEverywhereRuleset&) = delete;
+
+  // Maps |path| and validates it. Returns nullptr if the file is missing,
+  // has an unknown version or is malformed.
+  static std::unique_ptr<HTTPSEverywhereRuleset> Load(
+      const base::FilePath& path);
+  static std::unique_ptr<HTTPSEverywhereRuleset> CreateFromBuffer(
+      std::vector<uint8_t> buffer);
+
+  static uint32_t Hash(base::StringPiece key);
+
+  // Returns whether there are rules for |lookup_key|.
+  bool HasRules(base::StringPiece lookup_key) const;
+
+  // Compiles the rules stored for |lookup_key|. Returns nullptr if there are
+  // none.
+  std::unique_ptr<HTTPSEverywhereRules> GetRules(
+      base::StringPiece lookup_key) const;
+
+  // Applies the rules stored for |lookup_key| to |url| and returns the
+  // rewritten URL, or an empty string if no rule applies.
+  std::string ApplyRules(base::StringPiece lookup_key,
+                         const std::string& url) const;
+
+  size_t host_count() const { return header_->host_count; }
+
+ private:
+  HTTPSEverywhereRuleset();
+
+  bool Init(base::span<const uint8_t> data);
+  const HostEntry* FindHost(base::StringPiece lookup_key) const;
+  base::StringPiece GetString(const StringRef& ref) const;
+
+  std::unique_ptr<base::MemoryMappedFile> mapped_file_;
+  std::vector<uint8_t> buffer_;
+
+  const Header* header_ = nullptr;
+  base::span<const uint32_t> buckets_;
+  base::span<const HostEntry> hosts_;
+  base::span<const RuleSetEntry> rule_sets_;
+  base::span<const TargetEntry> targets_;
+  base::span<const StringRef> exclusions_;
+  base::span<const RuleEntry> rules_;
+  base::StringPiece strings_;
+};
+
+// Builds the binary format read by HTTPSEverywhereRuleset from the JSON
+// values stored in the LevelDB database.
+class HTTPSEverywhereRulesetBuilder {
+ public:
+  HTTPSEverywhereRulesetBuilder();
+  ~HTTPSEverywhereRulesetBuilder();
+
+  HTTPSEverywhereRulesetBuilder(const HTTPSEverywhereRulesetBuilder&) = delete;
+  HTTPSEverywhereRulesetBuilder& operator=(
+      const HTTPSEverywhereRulesetBuilder&) = delete;
+
+  // Adds the JSON rule list |rules_json| for |lookup_key|. Returns false if
+  // the value can't be parsed.
+  bool AddHost(const std::string& lookup_key, const std::string& rules_json);
+
+  std::vector<uint8_t> Build() const;
+
+ private:
+  uint32_t AddString(const std::string& value);
+  HTTPSEverywhereRuleset::StringRef AddStringRef(const std::string& value);
+
+  std::vector<std::pair<std::string, uint32_t>> hosts_;
+  std::vector<HTTPSEverywhereRuleset::RuleSetEntry> rule_sets_;
+  std::vector<HTTPSEverywhereRuleset::TargetEntry> targets_;
+  std::vector<HTTPSEverywhereRuleset::StringRef> exclusions_;
+  std::vector<HTTPSEverywhereRuleset::RuleEntry> rules_;
+  std::string strings_;
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_RULESET_H_
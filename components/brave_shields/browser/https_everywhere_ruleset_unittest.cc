@@ -0,0 +1,109 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/https_everywhere_ruleset.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace brave_shields {
+
+namespace {
+
+std::unique_ptr<HTTPSEverywhereRuleset> BuildRuleset(
+    const std::vector<std::pair<std::string, std::string>>& hosts) {
+  HTTPSEverywhereRulesetBuilder builder;
+  for (const auto& host : hosts)
+    EXPECT_TRUE(builder.AddHost(host.first, host.second));
+  return HTTPSEverywhereRuleset::CreateFromBuffer(builder.Build());
+}
+
+}  // namespace
+
+TEST(HTTPSEverywhereRulesetTest, RewritesMatchingHosts) {
+  auto ruleset = BuildRuleset({
+      {"com.example",
+       R"([{"r": [{"f": "^http://example\\.com/(.*)",
+                   "t": "https://www.example.com/$1"}]}])"},
+      {"org.example.*", R"([{"r": [{"d": 1}]}])"},
+  });
+  ASSERT_TRUE(ruleset);
+  EXPECT_EQ(2u, ruleset->host_count());
+
+  EXPECT_EQ("https://www.example.com/path",
+            ruleset->ApplyRules("com.example", "http://example.com/path"));
+  EXPECT_EQ("https://sub.example.org/",
+            ruleset->ApplyRules("org.example.*", "http://sub.example.org/"));
+
+  EXPECT_TRUE(ruleset->HasRules("com.example"));
+  EXPECT_FALSE(ruleset->HasRules("com.example.*"));
+  EXPECT_EQ("", ruleset->ApplyRules("net.example", "http://example.net/"));
+}
+
+TEST(HTTPSEverywhereRulesetTest, ExclusionsAndMissingRules) {
+  auto ruleset = BuildRuleset({
+      {"com.example",
+       R"([{"e": [{"p": "^http://example\\.com/skip"}],
+            "r": [{"d": 1}]}])"},
+      {"com.brave", R"([{"e": []}, {"r": [{"d": 1}]}])"},
+      {"com.brave.*",
+       R"([{"r": [{"f": "^http://nomatch/", "t": "https://nomatch/"}]},
+           {"r": [{"d": 1}]}])"},
+  });
+  ASSERT_TRUE(ruleset);
+
+  EXPECT_EQ("", ruleset->ApplyRules("com.example", "http://example.com/skip"));
+  EXPECT_EQ("https://example.com/ok",
+            ruleset->ApplyRules("com.example", "http://example.com/ok"));
+  // A target without rules stops the lookup, as with the JSON rules.
+  EXPECT_EQ("", ruleset->ApplyRules("com.brave", "http://brave.com/"));
+  // Otherwise targets are tried in order.
+  EXPECT_EQ("https://www.brave.com/",
+            ruleset->ApplyRules("com.brave.*", "http://www.brave.com/"));
+}
+
+TEST(HTTPSEverywhereRulesetTest, LoadFromFile) {
+  HTTPSEverywhereRulesetBuilder builder;
+  ASSERT_TRUE(builder.AddHost("com.example", R"([{"r": [{"d": 1}]}])"));
+  EXPECT_FALSE(builder.AddHost("com.broken", "{not json"));
+  const std::vector<uint8_t> data = builder.Build();
+
+  base::ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+  const base::FilePath path = temp_dir.GetPath().AppendASCII("httpse.ruleset");
+  ASSERT_TRUE(base::WriteFile(path, data));
+
+  auto ruleset = HTTPSEverywhereRuleset::Load(path);
+  ASSERT_TRUE(ruleset);
+  EXPECT_EQ("https://example.com/",
+            ruleset->ApplyRules("com.example", "http://example.com/"));
+  EXPECT_FALSE(ruleset->HasRules("com.broken"));
+
+  EXPECT_FALSE(HTTPSEverywhereRuleset::Load(
+      temp_dir.GetPath().AppendASCII("missing.ruleset")));
+}
+
+TEST(HTTPSEverywhereRulesetTest, RejectsMalformedData) {
+  HTTPSEverywhereRulesetBuilder builder;
+  ASSERT_TRUE(builder.AddHost("com.example", R"([{"r": [{"d": 1}]}])"));
+  std::vector<uint8_t> data = builder.Build();
+
+  std::vector<uint8_t> truncated(data.begin(), data.end() - 1);
+  EXPECT_FALSE(HTTPSEverywhereRuleset::CreateFromBuffer(truncated));
+
+  std::vector<uint8_t> bad_version(data);
+  bad_version[4]++;
+  EXPECT_FALSE(HTTPSEverywhereRuleset::CreateFromBuffer(bad_version));
+
+  EXPECT_FALSE(HTTPSEverywhereRuleset::CreateFromBuffer({}));
+}
+
+}  // namespace brave_shields
@@ -12,22 +12,25 @@
 
 #include "base/base_paths.h"
 #include "base/bind.h"
-#include "base/json/json_reader.h"
+#include "base/feature_list.h"
 #include "base/logging.h"
 #include "base/macros.h"
 #include "base/memory/ptr_util.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/threading/scoped_blocking_call.h"
-#include "base/values.h"
+#include "brave/components/brave_shields/browser/https_everywhere_rules.h"
+#include "brave/components/brave_shields/browser/https_everywhere_ruleset.h"
+#include "brave/components/brave_shields/common/features.h"
 #include "third_party/leveldatabase/src/include/leveldb/db.h"
-#include "third_party/re2/src/re2/re2.h"
 #include "third_party/zlib/google/zip.h"
 
 #define DAT_FILE "httpse.leveldb.zip"
+#define RULESET_FILE "httpse.ruleset"
 #define DAT_FILE_VERSION "6.0"
 #define HTTPSE_URLS_REDIRECTS_COUNT_QUEUE   1
 #define HTTPSE_URL_MAX_REDIRECTS_COUNT      5
+#define HTTPSE_CACHE_SHARD_COUNT            8
 
 namespace {
 
@@ -101,12 +104,23 @@ HTTPSEverywhereService::g_https_everywhere_component_base64_public_key_(
 HTTPSEverywhereService::HTTPSEverywhereService(
     BraveComponent::Delegate* delegate)
     : BaseBraveShieldsService(delegate),
+      host_caches_enabled_(base::FeatureList::IsEnabled(
+          features::kBraveHTTPSEverywhereHostCaches)),
+      recently_used_cache_(
+          std::max(1, features::kBraveHTTPSEverywhereURLCacheSize.Get()),
+          HTTPSE_CACHE_SHARD_COUNT),
+      no_rules_host_cache_(
+          std::max(1, features::kBraveHTTPSEverywhereNoRulesCacheSize.Get()),
+          HTTPSE_CACHE_SHARD_COUNT),
+      rules_cache_(
+          std::max(1, features::kBraveHTTPSEverywhereRulesCacheSize.Get())),
       level_db_(nullptr) {
   DETACH_FROM_SEQUENCE(sequence_checker_);
 }
 
 HTTPSEverywhereService::~HTTPSEverywhereService() {
   GetTaskRunner()->DeleteSoon(FROM_HERE, level_db_);
+  GetTaskRunner()->DeleteSoon(FROM_HERE, std::move(ruleset_));
 }
 
 bool HTTPSEverywhereService::Init() {
@@ -116,8 +130,25 @@ bool HTTPSEverywhereService::Init() {
   return true;
 }
 
+bool HTTPSEverywhereService::InitRuleset(const base::FilePath& install_dir) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  base::FilePath ruleset_file_path =
+      install_dir.AppendASCII(DAT_FILE_VERSION).AppendASCII(RULESET_FILE);
+  ruleset_ = HTTPSEverywhereRuleset::Load(ruleset_file_path);
+  return !!ruleset_;
+}
+
 void HTTPSEverywhereService::InitDB(const base::FilePath& install_dir) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  CloseDatabase();
+  recently_used_cache_.clear();
+  no_rules_host_cache_.clear();
+  rules_cache_.Clear();
+  if (InitRuleset(install_dir))
+    return;
+
+  // Fall back to the LevelDB database for components which don't ship the
+  // precompiled ruleset.
   base::FilePath zip_db_file_path =
       install_dir.AppendASCII(DAT_FILE_VERSION).AppendASCII(DAT_FILE);
   base::FilePath unzipped_level_db_path = zip_db_file_path.RemoveExtension();
@@ -128,8 +159,6 @@ void HTTPSEverywhereService::InitDB(const base::FilePath& install_dir) {
     return;
   }
 
-  CloseDatabase();
-
   leveldb::Options options;
   leveldb::Status status =
       leveldb::DB::Open(options,
@@ -162,7 +191,8 @@ bool HTTPSEverywhereService::GetHTTPSURL(
   if (!url->is_valid())
     return false;
 
-  if (!IsInitialized() || !level_db_ || url->scheme() == url::kHttpsScheme) {
+  if (!IsInitialized() || (!level_db_ && !ruleset_) ||
+      url->scheme() == url::kHttpsScheme) {
     return false;
   }
   if (!ShouldHTTPSERedirect(request_identifier)) {
@@ -181,24 +211,61 @@ bool HTTPSEverywhereService::GetHTTPSURL(
     candidate_url = candidate_url.ReplaceComponents(replacements);
   }
 
+  bool no_rules = false;
+  if (host_caches_enabled_ &&
+      no_rules_host_cache_.get(candidate_url.host(), &no_rules)) {
+    return false;
+  }
+
   SCOPED_UMA_HISTOGRAM_TIMER("Brave.HTTPSE.GetHTTPSURL");
   const std::vector<std::string> domains =
       ExpandDomainForLookup(candidate_url.host());
+  bool host_has_rules = false;
   for (auto domain : domains) {
-    std::string value = leveldbGet(level_db_, domain);
-    if (!value.empty()) {
-      *new_url = ApplyHTTPSRule(candidate_url.spec(), value);
-      if (0 != new_url->length()) {
-        recently_used_cache_.add(candidate_url.spec(), *new_url);
-        AddHTTPSEUrlToRedirectList(request_identifier);
-        return true;
-      }
+    const HTTPSEverywhereRules* rules = GetRules(domain);
+    if (!rules)
+      continue;
+    host_has_rules = true;
+    *new_url = rules->Apply(candidate_url.spec());
+    if (0 != new_url->length()) {
+      recently_used_cache_.add(candidate_url.spec(), *new_url);
+      AddHTTPSEUrlToRedirectList(request_identifier);
+      return true;
     }
   }
   recently_used_cache_.remove(candidate_url.spec());
+  if (host_caches_enabled_ && !host_has_rules)
+    no_rules_host_cache_.add(candidate_url.host(), true);
   return false;
 }
 
+const HTTPSEverywhereRules* HTTPSEverywhereService::GetRules(
+    const std::string& lookup_key) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  if (!host_caches_enabled_) {
+    uncached_rules_ = LoadRules(lookup_key);
+    return uncached_rules_.get();
+  }
+
+  auto it = rules_cache_.Get(lookup_key);
+  UMA_HISTOGRAM_BOOLEAN("Brave.HTTPSE.RulesCacheHit",
+                        it != rules_cache_.end());
+  if (it == rules_cache_.end())
+    it = rules_cache_.Put(lookup_key, LoadRules(lookup_key));
+  return it->second.get();
+}
+
+std::unique_ptr<HTTPSEverywhereRules> HTTPSEverywhereService::LoadRules(
+    const std::string& lookup_key) {
+  if (ruleset_)
+    return ruleset_->GetRules(lookup_key);
+
+  std::string value = leveldbGet(level_db_, lookup_key);
+  if (value.empty())
+    return nullptr;
+  return HTTPSEverywhereRules::FromJSON(value);
+}
+
 bool HTTPSEverywhereService::GetHTTPSURLFromCacheOnly(
     const GURL* url,
     const uint64_t& request_identifier,
@@ -213,10 +280,27 @@ bool HTTPSEverywhereService::GetHTTPSURLFromCacheOnly(
     return false;
   }
 
-  if (recently_used_cache_.get(url->spec(), cached_url)) {
+  const bool url_cache_hit = recently_used_cache_.get(url->spec(), cached_url);
+  UMA_HISTOGRAM_BOOLEAN("Brave.HTTPSE.URLCacheHit", url_cache_hit);
+  if (url_cache_hit) {
     AddHTTPSEUrlToRedirectList(request_identifier);
     return true;
   }
+
+  if (!host_caches_enabled_)
+    return false;
+
+  // A known host without rules is answered here, without a round trip to the
+  // task runner.
+  bool no_rules = false;
+  const bool no_rules_cache_hit =
+      no_rules_host_cache_.get(url->host(), &no_rules);
+  UMA_HISTOGRAM_BOOLEAN("Brave.HTTPSE.NoRulesHostCacheHit",
+                        no_rules_cache_hit);
+  if (no_rules_cache_hit) {
+    cached_url->clear();
+    return true;
+  }
   return false;
 }
 
@@ -262,124 +346,13 @@ void HTTPSEverywhereService::AddHTTPSEUrlToRedirectList(
   }
 }
 
-std::string HTTPSEverywhereService::ApplyHTTPSRule(
-    const std::string& originalUrl,
-    const std::string& rule) {
-  absl::optional<base::Value> json_object = base::JSONReader::Read(rule);
-  if (absl::nullopt == json_object || !json_object->is_list()) {
-    return "";
-  }
-
-  base::Value::ConstListView topValues = json_object->GetList();
-  for (auto it = topValues.cbegin(); it != topValues.cend(); ++it) {
-    if (!it->is_dict()) {
-      continue;
-    }
-    const base::DictionaryValue* childTopDictionary = nullptr;
-    it->GetAsDictionary(&childTopDictionary);
-    if (nullptr == childTopDictionary) {
-      continue;
-    }
-
-    const base::Value* exclusion = nullptr;
-    if (childTopDictionary->Get("e", &exclusion)) {
-      const base::ListValue* eValues = nullptr;
-      exclusion->GetAsList(&eValues);
-      if (nullptr != eValues) {
-        for (size_t j = 0; j < eValues->GetList().size(); ++j) {
-          const base::Value* pValue = nullptr;
-          if (!eValues->Get(j, &pValue)) {
-            continue;
-          }
-          const base::DictionaryValue* pDictionary = nullptr;
-          pValue->GetAsDictionary(&pDictionary);
-          if (nullptr == pDictionary) {
-            continue;
-          }
-          const base::Value* patternValue = nullptr;
-          if (!pDictionary->Get("p", &patternValue)) {
-            continue;
-          }
-          std::string pattern;
-          if (!patternValue->GetAsString(&pattern)) {
-            continue;
-          }
-          pattern = CorrecttoRuleToRE2Engine(pattern);
-          if (RE2::FullMatch(originalUrl, pattern)) {
-            return "";
-          }
-        }
-      }
-    }
-
-    const base::Value* rules = nullptr;
-    if (!childTopDictionary->Get("r", &rules)) {
-      return "";
-    }
-    const base::ListValue* rValues = nullptr;
-    rules->GetAsList(&rValues);
-    if (nullptr == rValues) {
-      return "";
-    }
-
-    for (size_t j = 0; j < rValues->GetList().size(); ++j) {
-      const base::Value* pValue = nullptr;
-      if (!rValues->Get(j, &pValue)) {
-        continue;
-      }
-      const base::DictionaryValue* pDictionary = nullptr;
-      pValue->GetAsDictionary(&pDictionary);
-      if (nullptr == pDictionary) {
-        continue;
-      }
-      const base::Value* patternValue = nullptr;
-      if (pDictionary->Get("d", &patternValue)) {
-        std::string newUrl(originalUrl);
-        return newUrl.insert(4, "s");
-      }
-
-      const base::Value* from_value = nullptr;
-      const base::Value* to_value = nullptr;
-      if (!pDictionary->Get("f", &from_value) ||
-          !pDictionary->Get("t", &to_value)) {
-        continue;
-      }
-      std::string from, to;
-      if (!from_value->GetAsString(&from) ||
-          !to_value->GetAsString(&to)) {
-        continue;
-      }
-
-      to = CorrecttoRuleToRE2Engine(to);
-      std::string newUrl(originalUrl);
-      RE2 regExp(from);
-
-      if (RE2::Replace(&newUrl, regExp, to) && newUrl != originalUrl) {
-        return newUrl;
-      }
-    }
-  }
-  return "";
-}
-
-std::string HTTPSEverywhereService::CorrecttoRuleToRE2Engine(
-    const std::string& to) {
-  std::string correctedto(to);
-  size_t pos = to.find("$");
-  while (std::string::npos != pos) {
-    correctedto[pos] = '\\';
-    pos = correctedto.find("$");
-  }
-
-  return correctedto;
-}
-
 void HTTPSEverywhereService::CloseDatabase() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
   if (level_db_) {
     delete level_db_;
     level_db_ = nullptr;
   }
+  ruleset_.reset();
 }
 
 // static
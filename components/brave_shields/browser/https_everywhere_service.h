@@ -10,6 +10,7 @@
 #include <string>
 #include <vector>
 
+#include "base/containers/mru_cache.h"
 #include "base/files/file_path.h"
 #include "base/memory/weak_ptr.h"
 #include "base/sequence_checker.h"
@@ -27,6 +28,9 @@ using brave_component_updater::BraveComponent;
 
 namespace brave_shields {
 
+class HTTPSEverywhereRules;
+class HTTPSEverywhereRuleset;
+
 extern const char kHTTPSEverywhereComponentName[];
 extern const char kHTTPSEverywhereComponentId[];
 extern const char kHTTPSEverywhereComponentBase64PublicKey[];
@@ -63,9 +67,6 @@ class HTTPSEverywhereService : public BaseBraveShieldsService,
 
   void AddHTTPSEUrlToRedirectList(const uint64_t& request_id);
   bool ShouldHTTPSERedirect(const uint64_t& request_id);
-  std::string ApplyHTTPSRule(const std::string& originalUrl,
-      const std::string& rule);
-  std::string CorrecttoRuleToRE2Engine(const std::string& to);
 
  private:
   friend class ::HTTPSEverywhereServiceTest;
@@ -80,11 +81,31 @@ class HTTPSEverywhereService : public BaseBraveShieldsService,
   void CloseDatabase();
 
   void InitDB(const base::FilePath& install_dir);
+  // Loads the precompiled ruleset shipped next to the LevelDB archive, if any.
+  bool InitRuleset(const base::FilePath& install_dir);
+
+  // Returns the compiled rules for |lookup_key|, or nullptr if there are none.
+  // The result is only valid until the next call.
+  const HTTPSEverywhereRules* GetRules(const std::string& lookup_key);
+  std::unique_ptr<HTTPSEverywhereRules> LoadRules(
+      const std::string& lookup_key);
 
   base::Lock httpse_get_urls_redirects_count_mutex_;
   std::vector<HTTPSE_REDIRECTS_COUNT_ST> httpse_urls_redirects_count_;
+  const bool host_caches_enabled_;
+  // Rewritten URLs, keyed by the original URL spec.
   HTTPSERecentlyUsedCache<std::string> recently_used_cache_;
+  // Hosts known to have no rule at any lookup level, so their requests don't
+  // need to leave the UI thread.
+  HTTPSERecentlyUsedCache<bool> no_rules_host_cache_;
+  // Compiled rules by lookup key, nullptr when the key has no rules. Only used
+  // on the task runner.
+  base::MRUCache<std::string, std::unique_ptr<HTTPSEverywhereRules>>
+      rules_cache_;
+  std::unique_ptr<HTTPSEverywhereRules> uncached_rules_;
   leveldb::DB* level_db_;
+  // When present, used instead of |level_db_|.
+  std::unique_ptr<HTTPSEverywhereRuleset> ruleset_;
 
   SEQUENCE_CHECKER(sequence_checker_);
   DISALLOW_COPY_AND_ASSIGN(HTTPSEverywhereService);
@@ -0,0 +1,75 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+// Converts an unzipped httpse.leveldb database into the precompiled ruleset
+// loaded by HTTPSEverywhereService, e.g.
+//
+//   httpse_ruleset_converter --input=httpse.leveldb --output=httpse.ruleset
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/at_exit.h"
+#include "base/command_line.h"
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/logging.h"
+#include "brave/components/brave_shields/browser/https_everywhere_ruleset.h"
+#include "third_party/leveldatabase/src/include/leveldb/db.h"
+
+namespace {
+
+const char kInputSwitch[] = "input";
+const char kOutputSwitch[] = "output";
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  base::AtExitManager at_exit;
+  base::CommandLine::Init(argc, argv);
+  auto* command_line = base::CommandLine::ForCurrentProcess();
+
+  const base::FilePath input = command_line->GetSwitchValuePath(kInputSwitch);
+  const base::FilePath output = command_line->GetSwitchValuePath(kOutputSwitch);
+  if (input.empty() || output.empty()) {
+    LOG(ERROR) << "usage: httpse_ruleset_converter --input=<leveldb dir> "
+                  "--output=<ruleset file>";
+    return 1;
+  }
+
+  leveldb::DB* db_ptr = nullptr;
+  leveldb::Status status =
+      leveldb::DB::Open(leveldb::Options(), input.AsUTF8Unsafe(), &db_ptr);
+  if (!status.ok()) {
+    LOG(ERROR) << "Level db open error " << input << ", error: "
+               << status.ToString();
+    return 1;
+  }
+  std::unique_ptr<leveldb::DB> db(db_ptr);
+
+  brave_shields::HTTPSEverywhereRulesetBuilder builder;
+  size_t skipped = 0;
+  std::unique_ptr<leveldb::Iterator> it(
+      db->NewIterator(leveldb::ReadOptions()));
+  for (it->SeekToFirst(); it->Valid(); it->Next()) {
+    if (!builder.AddHost(it->key().ToString(), it->value().ToString()))
+      skipped++;
+  }
+  if (!it->status().ok()) {
+    LOG(ERROR) << "Level db read error: " << it->status().ToString();
+    return 1;
+  }
+
+  const std::vector<uint8_t> ruleset = builder.Build();
+  if (!base::WriteFile(output, ruleset)) {
+    LOG(ERROR) << "Failed to write " << output;
+    return 1;
+  }
+
+  if (skipped)
+    LOG(WARNING) << "Skipped " << skipped << " malformed entries";
+  return 0;
+}
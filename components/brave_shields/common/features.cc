@@ -30,6 +30,10 @@ const base::Feature kBraveAdblockCosmeticFiltering{
     base::FEATURE_ENABLED_BY_DEFAULT};
 const base::Feature kBraveAdblockCspRules{
     "BraveAdblockCspRules", base::FEATURE_ENABLED_BY_DEFAULT};
+// When enabled, Brave will compile all filter list subscriptions and custom
+// filters into a single adblock engine instead of keeping one engine per list.
+const base::Feature kBraveAdblockMergedListEngine{
+    "BraveAdblockMergedListEngine", base::FEATURE_DISABLED_BY_DEFAULT};
 // When enabled, Brave will block domains listed in the user's selected adblock
 // filters and present a security interstitial with choice to proceed and
 // optionally whitelist the domain.
@@ -44,8 +48,19 @@ const base::Feature kBraveExtensionNetworkBlocking{
 // When enabled, Brave will always report Light in Fingerprinting: Strict mode
 const base::Feature kBraveDarkModeBlock{"BraveDarkModeBlock",
                                         base::FEATURE_ENABLED_BY_DEFAULT};
-// load the cosmetic filter rules using sync ipc
+// fall back to loading the cosmetic filter rules using sync ipc if the async
+// request made at commit has not been answered by document start
 const base::Feature kCosmeticFilteringSyncLoad{
     "CosmeticFilterSyncLoad", base::FEATURE_ENABLED_BY_DEFAULT};
+// When enabled, HTTPS Everywhere remembers hosts without any rule and keeps
+// the compiled rules of recently used hosts. The params size its caches.
+const base::Feature kBraveHTTPSEverywhereHostCaches{
+    "BraveHTTPSEverywhereHostCaches", base::FEATURE_ENABLED_BY_DEFAULT};
+const base::FeatureParam<int> kBraveHTTPSEverywhereURLCacheSize{
+    &kBraveHTTPSEverywhereHostCaches, "url_cache_size", 100};
+const base::FeatureParam<int> kBraveHTTPSEverywhereNoRulesCacheSize{
+    &kBraveHTTPSEverywhereHostCaches, "no_rules_cache_size", 1024};
+const base::FeatureParam<int> kBraveHTTPSEverywhereRulesCacheSize{
+    &kBraveHTTPSEverywhereHostCaches, "rules_cache_size", 128};
 }  // namespace features
 }  // namespace brave_shields
@@ -6,6 +6,8 @@
 #ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_COMMON_FEATURES_H_
 #define BRAVE_COMPONENTS_BRAVE_SHIELDS_COMMON_FEATURES_H_
 
+#include "base/metrics/field_trial_params.h"
+
 namespace base {
 struct Feature;
 }  // namespace base
@@ -17,10 +19,15 @@ extern const base::Feature kBraveAdblockCnameUncloaking;
 extern const base::Feature kBraveAdblockCollapseBlockedElements;
 extern const base::Feature kBraveAdblockCosmeticFiltering;
 extern const base::Feature kBraveAdblockCspRules;
+extern const base::Feature kBraveAdblockMergedListEngine;
 extern const base::Feature kBraveDomainBlock;
 extern const base::Feature kBraveExtensionNetworkBlocking;
 extern const base::Feature kBraveDarkModeBlock;
 extern const base::Feature kCosmeticFilteringSyncLoad;
+extern const base::Feature kBraveHTTPSEverywhereHostCaches;
+extern const base::FeatureParam<int> kBraveHTTPSEverywhereURLCacheSize;
+extern const base::FeatureParam<int> kBraveHTTPSEverywhereNoRulesCacheSize;
+extern const base::FeatureParam<int> kBraveHTTPSEverywhereRulesCacheSize;
 }  // namespace features
 }  // namespace brave_shields
 
@@ -29,13 +29,13 @@ void CosmeticFiltersResources::HiddenClassIdSelectors(
   absl::optional<base::Value> input_value = base::JSONReader::Read(input);
   if (!input_value || !input_value->is_dict()) {
     // Nothing to work with
-    std::move(callback).Run(base::Value());
+    std::move(callback).Run(std::vector<std::string>());
 
     return;
   }
   base::DictionaryValue* input_dict;
   if (!input_value->GetAsDictionary(&input_dict)) {
-    std::move(callback).Run(base::Value());
+    std::move(callback).Run(std::vector<std::string>());
 
     return;
   }
@@ -60,19 +60,28 @@ void CosmeticFiltersResources::HiddenClassIdSelectors(
     }
   }
 
-  auto selectors =
-      ad_block_service_->HiddenClassIdSelectors(classes, ids, exceptions);
-
-  std::move(callback).Run(selectors ? std::move(selectors.value())
-                                    : base::Value());
+  std::move(callback).Run(
+      ad_block_service_->HiddenClassIdSelectors(classes, ids, exceptions));
 }
 
 void CosmeticFiltersResources::UrlCosmeticResources(
     const std::string& url,
     UrlCosmeticResourcesCallback callback) {
-  auto resources = ad_block_service_->UrlCosmeticResources(url);
-  std::move(callback).Run(resources ? std::move(resources.value())
-                                    : base::Value());
+  adblock::UrlCosmeticResources resources =
+      ad_block_service_->UrlCosmeticResources(url);
+
+  auto result = mojom::UrlCosmeticResources::New();
+  result->hide_selectors = std::move(resources.hide_selectors);
+  result->force_hide_selectors = std::move(resources.force_hide_selectors);
+  for (auto& style_selector : resources.style_selectors) {
+    result->style_selectors.emplace(style_selector.first,
+                                    std::move(style_selector.second));
+  }
+  result->exceptions = std::move(resources.exceptions);
+  result->injected_script = std::move(resources.injected_script);
+  result->generichide = resources.generichide;
+
+  std::move(callback).Run(std::move(result));
 }
 
 }  // namespace cosmetic_filters
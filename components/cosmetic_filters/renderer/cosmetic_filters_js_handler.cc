@@ -8,7 +8,8 @@
 #include <utility>
 
 #include "base/bind.h"
-#include "base/json/json_writer.h"
+#include "base/containers/flat_map.h"
+#include "base/json/string_escape.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/no_destructor.h"
 #include "base/strings/stringprintf.h"
@@ -188,6 +189,37 @@ bool IsVettedSearchEngine(const GURL& url) {
   return false;
 }
 
+// Serializes |list| as a JS array literal of strings, without going through
+// base::Value.
+std::string ToJSArrayLiteral(const std::vector<std::string>& list) {
+  std::string result = "[";
+  for (size_t i = 0; i < list.size(); ++i) {
+    if (i)
+      result += ',';
+    base::EscapeJSONString(list[i], true, &result);
+  }
+  result += ']';
+  return result;
+}
+
+// Serializes |map| as a JS object literal mapping each selector to its array
+// of styles.
+std::string ToJSObjectLiteral(
+    const base::flat_map<std::string, std::vector<std::string>>& map) {
+  std::string result = "{";
+  bool first = true;
+  for (const auto& entry : map) {
+    if (!first)
+      result += ',';
+    first = false;
+    base::EscapeJSONString(entry.first, true, &result);
+    result += ':';
+    result += ToJSArrayLiteral(entry.second);
+  }
+  result += '}';
+  return result;
+}
+
 }  // namespace
 
 namespace cosmetic_filters {
@@ -300,10 +332,12 @@ void CosmeticFiltersJSHandler::OnRemoteDisconnect() {
   EnsureConnected();
 }
 
-bool CosmeticFiltersJSHandler::ProcessURL(
-    const GURL& url,
-    absl::optional<base::OnceClosure> callback) {
-  resources_dict_.reset();
+bool CosmeticFiltersJSHandler::ProcessURL(const GURL& url,
+                                          base::OnceClosure callback) {
+  resources_.reset();
+  // Drop the reply to any request made for the previous URL.
+  ++request_id_;
+  request_in_flight_ = false;
   url_ = url;
   enabled_1st_party_cf_ = false;
 
@@ -322,48 +356,52 @@ bool CosmeticFiltersJSHandler::ProcessURL(
   enabled_1st_party_cf_ =
       content_settings->IsFirstPartyCosmeticFilteringEnabled(url_);
 
-  if (callback.has_value()) {
-    SCOPED_UMA_HISTOGRAM_TIMER_MICROS(
-        "Brave.CosmeticFilters.UrlCosmeticResources");
-    cosmetic_filters_resources_->UrlCosmeticResources(
-        url_.spec(),
-        base::BindOnce(&CosmeticFiltersJSHandler::OnUrlCosmeticResources,
-                       base::Unretained(this), std::move(callback.value())));
-  } else {
-    SCOPED_UMA_HISTOGRAM_TIMER_MICROS(
-        "Brave.CosmeticFilters.UrlCosmeticResourcesSync");
-    base::Value result;
-    cosmetic_filters_resources_->UrlCosmeticResources(url_.spec(), &result);
-    resources_dict_ = base::DictionaryValue::From(
-        base::Value::ToUniquePtrValue(std::move(result)));
-  }
+  SCOPED_UMA_HISTOGRAM_TIMER_MICROS(
+      "Brave.CosmeticFilters.UrlCosmeticResources");
+  request_in_flight_ = true;
+  cosmetic_filters_resources_->UrlCosmeticResources(
+      url_.spec(),
+      base::BindOnce(&CosmeticFiltersJSHandler::OnUrlCosmeticResources,
+                     base::Unretained(this), std::move(callback),
+                     ++request_id_));
+
+  return true;
+}
+
+bool CosmeticFiltersJSHandler::FetchPendingResourcesSync() {
+  if (!request_in_flight_ || !EnsureConnected())
+    return false;
+
+  SCOPED_UMA_HISTOGRAM_TIMER_MICROS(
+      "Brave.CosmeticFilters.UrlCosmeticResourcesSync");
+  // Supersede the async request, its reply is dropped when it arrives.
+  ++request_id_;
+  request_in_flight_ = false;
+  cosmetic_filters_resources_->UrlCosmeticResources(url_.spec(), &resources_);
 
   return true;
 }
 
 void CosmeticFiltersJSHandler::OnUrlCosmeticResources(
     base::OnceClosure callback,
-    base::Value result) {
-  if (!EnsureConnected())
+    uint64_t request_id,
+    mojom::UrlCosmeticResourcesPtr result) {
+  if (!EnsureConnected() || request_id != request_id_)
     return;
 
-  resources_dict_ = base::DictionaryValue::From(
-      base::Value::ToUniquePtrValue(std::move(result)));
+  request_in_flight_ = false;
+  resources_ = std::move(result);
   std::move(callback).Run();
 }
 
 void CosmeticFiltersJSHandler::ApplyRules() {
   blink::WebLocalFrame* web_frame = render_frame_->GetWebFrame();
-  if (!resources_dict_ || web_frame->IsProvisional())
+  if (!resources_ || web_frame->IsProvisional())
     return;
 
-  std::string scriptlet_script;
-  base::Value* injected_script = resources_dict_->FindPath("injected_script");
-  if (injected_script &&
-      base::JSONWriter::Write(*injected_script, &scriptlet_script)) {
-    scriptlet_script =
-        base::StringPrintf(kScriptletInitScript, scriptlet_script.c_str());
-  }
+  std::string scriptlet_script = base::StringPrintf(
+      kScriptletInitScript,
+      base::GetQuotedJSONString(resources_->injected_script).c_str());
   if (!scriptlet_script.empty()) {
     web_frame->ExecuteScriptInIsolatedWorld(
         isolated_world_id_, blink::WebString::FromUTF8(scriptlet_script),
@@ -374,11 +412,9 @@ void CosmeticFiltersJSHandler::ApplyRules() {
     return;
 
   // Working on css rules, we do that on a main frame only
-  bool generichide = false;
-  resources_dict_->GetBoolean("generichide", &generichide);
   std::string cosmetic_filtering_init_script = base::StringPrintf(
       kCosmeticFilteringInitScript, enabled_1st_party_cf_ ? "true" : "false",
-      generichide ? "true" : "false");
+      resources_->generichide ? "true" : "false");
   std::string pre_init_script = base::StringPrintf(
       kPreInitScript, cosmetic_filtering_init_script.c_str());
 
@@ -387,107 +423,63 @@ void CosmeticFiltersJSHandler::ApplyRules() {
       blink::BackForwardCacheAware::kAllow);
   ExecuteObservingBundleEntryPoint();
 
-  CSSRulesRoutine(resources_dict_.get());
+  CSSRulesRoutine(*resources_);
 }
 
 void CosmeticFiltersJSHandler::CSSRulesRoutine(
-    base::DictionaryValue* resources_dict) {
+    const mojom::UrlCosmeticResources& resources) {
   // Otherwise, if its a vetted engine AND we're not in aggressive
   // mode, also don't do cosmetic filtering.
   if (!enabled_1st_party_cf_ && IsVettedSearchEngine(url_))
     return;
 
   blink::WebLocalFrame* web_frame = render_frame_->GetWebFrame();
-  base::ListValue* cf_exceptions_list;
-  if (resources_dict->GetList("exceptions", &cf_exceptions_list)) {
-    for (size_t i = 0; i < cf_exceptions_list->GetList().size(); i++) {
-      exceptions_.push_back(cf_exceptions_list->GetList()[i].GetString());
-    }
-  }
-  base::ListValue* hide_selectors_list;
-  if (!resources_dict->GetList("hide_selectors", &hide_selectors_list)) {
-    hide_selectors_list = nullptr;
-  }
-  base::ListValue* force_hide_selectors_list;
-  if (!resources_dict->GetList("force_hide_selectors",
-                               &force_hide_selectors_list)) {
-    force_hide_selectors_list = nullptr;
-  }
+  exceptions_.insert(exceptions_.end(), resources.exceptions.begin(),
+                     resources.exceptions.end());
 
-  if (hide_selectors_list && hide_selectors_list->GetList().size() != 0) {
-    std::string json_selectors;
-    if (!base::JSONWriter::Write(*hide_selectors_list, &json_selectors) ||
-        json_selectors.empty()) {
-      json_selectors = "[]";
-    }
+  if (!resources.hide_selectors.empty()) {
     // Building a script for stylesheet modifications
-    std::string new_selectors_script =
-        base::StringPrintf(kHideSelectorsInjectScript, json_selectors.c_str());
+    std::string new_selectors_script = base::StringPrintf(
+        kHideSelectorsInjectScript,
+        ToJSArrayLiteral(resources.hide_selectors).c_str());
     web_frame->ExecuteScriptInIsolatedWorld(
         isolated_world_id_, blink::WebString::FromUTF8(new_selectors_script),
         blink::BackForwardCacheAware::kAllow);
   }
 
-  if (force_hide_selectors_list &&
-      force_hide_selectors_list->GetList().size() != 0) {
-    std::string json_selectors;
-    if (!base::JSONWriter::Write(*force_hide_selectors_list, &json_selectors) ||
-        json_selectors.empty()) {
-      json_selectors = "[]";
-    }
+  if (!resources.force_hide_selectors.empty()) {
     // Building a script for stylesheet modifications
     std::string new_selectors_script = base::StringPrintf(
-        kForceHideSelectorsInjectScript, json_selectors.c_str());
+        kForceHideSelectorsInjectScript,
+        ToJSArrayLiteral(resources.force_hide_selectors).c_str());
     web_frame->ExecuteScriptInIsolatedWorld(
         isolated_world_id_, blink::WebString::FromUTF8(new_selectors_script),
         blink::BackForwardCacheAware::kAllow);
   }
 
-  base::DictionaryValue* style_selectors_dictionary = nullptr;
-  if (resources_dict->GetDictionary("style_selectors",
-                                    &style_selectors_dictionary)) {
-    std::string json_selectors;
-    if (!base::JSONWriter::Write(*style_selectors_dictionary,
-                                 &json_selectors) ||
-        json_selectors.empty()) {
-      json_selectors = "[]";
-    }
-    std::string new_selectors_script =
-        base::StringPrintf(kStyleSelectorsInjectScript, json_selectors.c_str());
-    if (!json_selectors.empty()) {
-      web_frame->ExecuteScriptInIsolatedWorld(
-          isolated_world_id_, blink::WebString::FromUTF8(new_selectors_script),
-          blink::BackForwardCacheAware::kAllow);
-    }
-  }
+  std::string new_selectors_script = base::StringPrintf(
+      kStyleSelectorsInjectScript,
+      ToJSObjectLiteral(resources.style_selectors).c_str());
+  web_frame->ExecuteScriptInIsolatedWorld(
+      isolated_world_id_, blink::WebString::FromUTF8(new_selectors_script),
+      blink::BackForwardCacheAware::kAllow);
 
   if (!enabled_1st_party_cf_)
     ExecuteObservingBundleEntryPoint();
 }
 
-void CosmeticFiltersJSHandler::OnHiddenClassIdSelectors(base::Value result) {
+void CosmeticFiltersJSHandler::OnHiddenClassIdSelectors(
+    const std::vector<std::string>& result) {
   // If its a vetted engine AND we're not in aggressive
   // mode, don't do cosmetic filtering.
   if (!enabled_1st_party_cf_ && IsVettedSearchEngine(url_))
     return;
 
-  // We expect a List value from adblock service. That is
-  // an extra check to be sure that adblock file exist and gives us
-  // rules that we expect
-  base::ListValue* selectors_list;
-  if (!result.GetAsList(&selectors_list))
-    return;
-
   blink::WebLocalFrame* web_frame = render_frame_->GetWebFrame();
-  std::string json_selectors;
-  if (!base::JSONWriter::Write(*selectors_list, &json_selectors) ||
-      json_selectors.empty()) {
-    json_selectors = "[]";
-  }
-  // Building a script for stylesheet modifications
-  std::string new_selectors_script =
-      base::StringPrintf(kHideSelectorsInjectScript, json_selectors.c_str());
-  if (selectors_list->GetList().size() != 0) {
+  if (!result.empty()) {
+    // Building a script for stylesheet modifications
+    std::string new_selectors_script = base::StringPrintf(
+        kHideSelectorsInjectScript, ToJSArrayLiteral(result).c_str());
     web_frame->ExecuteScriptInIsolatedWorld(
         isolated_world_id_, blink::WebString::FromUTF8(new_selectors_script),
         blink::BackForwardCacheAware::kAllow);
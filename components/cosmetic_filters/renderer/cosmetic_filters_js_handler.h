@@ -6,6 +6,8 @@
 #ifndef BRAVE_COMPONENTS_COSMETIC_FILTERS_RENDERER_COSMETIC_FILTERS_JS_HANDLER_H_
 #define BRAVE_COMPONENTS_COSMETIC_FILTERS_RENDERER_COSMETIC_FILTERS_JS_HANDLER_H_
 
+#include <stdint.h>
+
 #include <memory>
 #include <string>
 #include <vector>
@@ -15,7 +17,6 @@
 #include "content/public/renderer/render_frame.h"
 #include "content/public/renderer/render_frame_observer.h"
 #include "mojo/public/cpp/bindings/remote.h"
-#include "third_party/abseil-cpp/absl/types/optional.h"
 #include "url/gurl.h"
 #include "v8/include/v8.h"
 
@@ -34,10 +35,14 @@ class CosmeticFiltersJSHandler {
   // Adds the "cs_worker" JavaScript object and its functions to the current
   // render_frame_.
   void AddJavaScriptObjectToFrame(v8::Local<v8::Context> context);
-  // Fetches an initial set of resources to inject into the page if cosmetic
-  // filtering is enabled, and returns whether or not to proceed with cosmetic
-  // filtering.
-  bool ProcessURL(const GURL& url, absl::optional<base::OnceClosure> callback);
+  // Starts fetching an initial set of resources to inject into the page if
+  // cosmetic filtering is enabled, and returns whether or not to proceed with
+  // cosmetic filtering. |callback| runs once the resources have arrived.
+  bool ProcessURL(const GURL& url, base::OnceClosure callback);
+  // Blocks on a sync IPC for the resources if the request started by
+  // ProcessURL() is still in flight. The pending callback is dropped in that
+  // case. Returns false if there is no request in flight.
+  bool FetchPendingResourcesSync();
   void ApplyRules();
 
  private:
@@ -62,9 +67,10 @@ class CosmeticFiltersJSHandler {
   void HiddenClassIdSelectors(const std::string& input);
 
   void OnUrlCosmeticResources(base::OnceClosure callback,
-                              base::Value result);
-  void CSSRulesRoutine(base::DictionaryValue* resources_dict);
-  void OnHiddenClassIdSelectors(base::Value result);
+                              uint64_t request_id,
+                              mojom::UrlCosmeticResourcesPtr result);
+  void CSSRulesRoutine(const mojom::UrlCosmeticResources& resources);
+  void OnHiddenClassIdSelectors(const std::vector<std::string>& result);
   bool OnIsFirstParty(const std::string& url_string);
 
   content::RenderFrame* render_frame_;
@@ -74,7 +80,11 @@ class CosmeticFiltersJSHandler {
   bool enabled_1st_party_cf_;
   std::vector<std::string> exceptions_;
   GURL url_;
-  std::unique_ptr<base::DictionaryValue> resources_dict_;
+  mojom::UrlCosmeticResourcesPtr resources_;
+  // Identifies the latest UrlCosmeticResources request, so that replies to
+  // requests which have been superseded are ignored.
+  uint64_t request_id_ = 0;
+  bool request_in_flight_ = false;
 
   // True if the content_cosmetic.bundle.js has injected in the current frame.
   bool bundle_injected_ = false;
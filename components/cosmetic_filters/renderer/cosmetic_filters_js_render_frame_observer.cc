@@ -7,6 +7,7 @@
 
 #include "base/bind.h"
 #include "base/feature_list.h"
+#include "base/metrics/histogram_macros.h"
 #include "brave/components/brave_shields/common/features.h"
 #include "content/public/renderer/render_frame.h"
 #include "third_party/abseil-cpp/absl/types/optional.h"
@@ -81,28 +82,35 @@ void CosmeticFiltersJsRenderFrameObserver::ReadyToCommitNavigation(
   if (!url_.SchemeIsHTTPOrHTTPS())
     return;
 
-  if (base::FeatureList::IsEnabled(
-          ::brave_shields::features::kCosmeticFilteringSyncLoad)) {
-    if (native_javascript_handle_->ProcessURL(url_, absl::nullopt)) {
-      ready_->Signal();
-    }
-  } else {
-    native_javascript_handle_->ProcessURL(
-        url_, absl::make_optional(base::BindOnce(
-                  &CosmeticFiltersJsRenderFrameObserver::OnProcessURL,
-                  weak_factory_.GetWeakPtr())));
-  }
+  // The resources are always requested asynchronously at commit, so that the
+  // browser works on them while the document is being loaded.
+  native_javascript_handle_->ProcessURL(
+      url_, base::BindOnce(&CosmeticFiltersJsRenderFrameObserver::OnProcessURL,
+                           weak_factory_.GetWeakPtr()));
 }
 
 void CosmeticFiltersJsRenderFrameObserver::RunScriptsAtDocumentStart() {
-  if (ready_->is_signaled()) {
+  const bool ready = ready_->is_signaled();
+  UMA_HISTOGRAM_BOOLEAN("Brave.CosmeticFilters.ResourcesReadyAtDocumentStart",
+                        ready);
+  if (ready) {
     ApplyRules();
-  } else {
-    ready_->Post(
-        FROM_HERE,
-        base::BindOnce(&CosmeticFiltersJsRenderFrameObserver::ApplyRules,
-                       weak_factory_.GetWeakPtr()));
+    return;
   }
+
+  // With sync loading, only block on the browser if the reply to the request
+  // made at commit has not arrived yet.
+  if (base::FeatureList::IsEnabled(
+          ::brave_shields::features::kCosmeticFilteringSyncLoad) &&
+      native_javascript_handle_->FetchPendingResourcesSync()) {
+    ready_->Signal();
+    ApplyRules();
+    return;
+  }
+
+  ready_->Post(FROM_HERE,
+               base::BindOnce(&CosmeticFiltersJsRenderFrameObserver::ApplyRules,
+                              weak_factory_.GetWeakPtr()));
 }
 
 void CosmeticFiltersJsRenderFrameObserver::ApplyRules() {
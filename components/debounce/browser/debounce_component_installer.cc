@@ -11,13 +11,11 @@
 #include "base/base_paths.h"
 #include "base/bind.h"
 #include "base/command_line.h"
-#include "base/json/json_reader.h"
 #include "base/logging.h"
 #include "base/macros.h"
 #include "base/task/thread_pool.h"
 #include "brave/components/brave_component_updater/browser/dat_file_util.h"
 #include "brave/components/brave_component_updater/browser/local_data_files_service.h"
-#include "net/base/registry_controlled_domains/registry_controlled_domain.h"
 
 using brave_component_updater::LocalDataFilesObserver;
 using brave_component_updater::LocalDataFilesService;
@@ -49,32 +47,13 @@ void DebounceComponentInstaller::OnDATFileDataReady(
     VLOG(1) << "Could not obtain debounce configuration";
     return;
   }
-  absl::optional<base::Value> root = base::JSONReader::Read(contents);
-  if (!root) {
+  std::unique_ptr<DebounceRuleIndex> rule_index =
+      DebounceRuleIndex::CreateFromJSON(contents);
+  if (!rule_index) {
     VLOG(1) << "Failed to parse debounce configuration";
     return;
   }
-  rules_.clear();
-  host_cache_.clear();
-  std::vector<std::string> hosts;
-  base::JSONValueConverter<DebounceRule> converter;
-  for (base::Value& it : root->GetList()) {
-    std::unique_ptr<DebounceRule> rule = std::make_unique<DebounceRule>();
-    if (!converter.Convert(it, rule.get()))
-      continue;
-    for (const URLPattern& pattern : rule->include_pattern_set()) {
-      if (!pattern.host().empty()) {
-        std::string etldp1 =
-            net::registry_controlled_domains::GetDomainAndRegistry(
-                pattern.host(),
-                net::registry_controlled_domains::PrivateRegistryFilter::
-                    INCLUDE_PRIVATE_REGISTRIES);
-        hosts.push_back(std::move(etldp1));
-      }
-    }
-    rules_.push_back(std::move(rule));
-  }
-  host_cache_ = std::move(hosts);
+  rule_index_ = std::move(rule_index);
   for (Observer& observer : observers_)
     observer.OnRulesReady(this);
 }
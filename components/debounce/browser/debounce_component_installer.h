@@ -10,15 +10,12 @@
 #include <string>
 #include <vector>
 
-#include "base/containers/flat_set.h"
 #include "base/files/file_path.h"
-#include "base/json/json_value_converter.h"
 #include "base/memory/weak_ptr.h"
 #include "base/observer_list.h"
 #include "base/sequence_checker.h"
-#include "base/values.h"
 #include "brave/components/brave_component_updater/browser/local_data_files_observer.h"
-#include "brave/components/debounce/browser/debounce_rule.h"
+#include "brave/components/debounce/browser/debounce_rule_index.h"
 #include "brave/components/debounce/browser/debounce_service.h"
 
 namespace debounce {
@@ -40,10 +37,8 @@ class DebounceComponentInstaller
       delete;
   ~DebounceComponentInstaller() override;
 
-  const std::vector<std::unique_ptr<DebounceRule>>& rules() const {
-    return rules_;
-  }
-  const base::flat_set<std::string>& host_cache() const { return host_cache_; }
+  // Returns nullptr until the rules have been loaded.
+  const DebounceRuleIndex* rule_index() const { return rule_index_.get(); }
 
   // implementation of brave_component_updater::LocalDataFilesObserver
   void OnComponentReady(const std::string& component_id,
@@ -69,8 +64,7 @@ class DebounceComponentInstaller
   void LoadDirectlyFromResourcePath();
 
   base::ObserverList<Observer> observers_;
-  std::vector<std::unique_ptr<DebounceRule>> rules_;
-  base::flat_set<std::string> host_cache_;
+  std::unique_ptr<DebounceRuleIndex> rule_index_;
   base::FilePath resource_dir_;
 
   base::WeakPtrFactory<DebounceComponentInstaller> weak_factory_{this};
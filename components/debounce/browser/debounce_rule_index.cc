@@ -0,0 +1,126 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/debounce/browser/debounce_rule_index.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "base/json/json_reader.h"
+#include "base/json/json_value_converter.h"
+#include "base/logging.h"
+#include "base/values.h"
+#include "net/base/registry_controlled_domains/registry_controlled_domain.h"
+#include "url/gurl.h"
+
+namespace debounce {
+
+namespace {
+
+std::string GetETLDPlusOne(const GURL& url) {
+  return net::registry_controlled_domains::GetDomainAndRegistry(
+      url, net::registry_controlled_domains::PrivateRegistryFilter::
+               INCLUDE_PRIVATE_REGISTRIES);
+}
+
+}  // namespace
+
+DebounceRuleIndex::DebounceRuleIndex(
+    std::vector<std::unique_ptr<DebounceRule>> rules)
+    : rules_(std::move(rules)) {
+  base::flat_map<std::string, std::vector<size_t>> rules_by_etldp1;
+  for (size_t i = 0; i < rules_.size(); ++i) {
+    bool any_site = false;
+    for (const URLPattern& pattern : rules_[i]->include_pattern_set()) {
+      std::string etldp1;
+      if (!pattern.host().empty()) {
+        etldp1 = net::registry_controlled_domains::GetDomainAndRegistry(
+            pattern.host(), net::registry_controlled_domains::
+                                PrivateRegistryFilter::
+                                    INCLUDE_PRIVATE_REGISTRIES);
+        // URLs are only considered if their eTLD+1 is named by a pattern,
+        // including the empty one (IP addresses, registries).
+        std::vector<size_t>& site_rules = rules_by_etldp1[etldp1];
+        if (site_rules.empty() || site_rules.back() != i)
+          site_rules.push_back(i);
+      }
+      // A pattern without a host, or on a registry such as *.co.uk, can match
+      // URLs on many sites.
+      if (etldp1.empty())
+        any_site = true;
+    }
+    if (any_site)
+      any_site_rules_.push_back(i);
+  }
+  rules_by_etldp1_ = std::move(rules_by_etldp1);
+}
+
+DebounceRuleIndex::~DebounceRuleIndex() = default;
+
+// static
+std::unique_ptr<DebounceRuleIndex> DebounceRuleIndex::CreateFromJSON(
+    const std::string& contents) {
+  absl::optional<base::Value> root = base::JSONReader::Read(contents);
+  if (!root || !root->is_list())
+    return nullptr;
+
+  std::vector<std::unique_ptr<DebounceRule>> rules;
+  base::JSONValueConverter<DebounceRule> converter;
+  for (base::Value& it : root->GetList()) {
+    std::unique_ptr<DebounceRule> rule = std::make_unique<DebounceRule>();
+    if (!converter.Convert(it, rule.get()))
+      continue;
+    rules.push_back(std::move(rule));
+  }
+  return std::make_unique<DebounceRuleIndex>(std::move(rules));
+}
+
+size_t DebounceRuleIndex::NextCandidate(const std::vector<size_t>* site_rules,
+                                        size_t start) const {
+  size_t next = rules_.size();
+  if (site_rules) {
+    auto it = std::lower_bound(site_rules->begin(), site_rules->end(), start);
+    if (it != site_rules->end())
+      next = *it;
+  }
+  auto it = std::lower_bound(any_site_rules_.begin(), any_site_rules_.end(),
+                             start);
+  if (it != any_site_rules_.end())
+    next = std::min(next, *it);
+  return next;
+}
+
+bool DebounceRuleIndex::Apply(const GURL& original_url,
+                              GURL* final_url) const {
+  // Check the index to see if this URL needs to have any debounce rules
+  // applied.
+  auto site = rules_by_etldp1_.find(GetETLDPlusOne(original_url));
+  if (site == rules_by_etldp1_.end())
+    return false;
+
+  bool changed = false;
+  GURL current_url = original_url;
+  const std::vector<size_t>* site_rules = &site->second;
+
+  // Debounce rules are applied in order. If one rule applies, the URL is
+  // changed to the debounced URL and we continue with the rules after it,
+  // looking up the candidates for the new URL's site. Previously checked rules
+  // are not reapplied; i.e. we never restart the loop.
+  for (size_t i = NextCandidate(site_rules, 0); i < rules_.size();
+       i = NextCandidate(site_rules, i + 1)) {
+    if (!rules_[i]->Apply(current_url, final_url) ||
+        current_url == *final_url) {
+      continue;
+    }
+    changed = true;
+    current_url = *final_url;
+    auto new_site = rules_by_etldp1_.find(GetETLDPlusOne(current_url));
+    site_rules =
+        new_site == rules_by_etldp1_.end() ? nullptr : &new_site->second;
+  }
+  return changed;
+}
+
+}  // namespace debounce
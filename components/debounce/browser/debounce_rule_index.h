@@ -0,0 +1,64 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_DEBOUNCE_BROWSER_DEBOUNCE_RULE_INDEX_H_
+#define BRAVE_COMPONENTS_DEBOUNCE_BROWSER_DEBOUNCE_RULE_INDEX_H_
+
+#include <stddef.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/containers/flat_map.h"
+#include "brave/components/debounce/browser/debounce_rule.h"
+
+class GURL;
+
+namespace debounce {
+
+// Debounce rules grouped by the eTLD+1 of their include patterns, so that a
+// URL only evaluates the rules that could match it. Rules whose include
+// patterns can match any site (no host, or a host that is itself a registry)
+// are candidates for every URL.
+class DebounceRuleIndex {
+ public:
+  explicit DebounceRuleIndex(std::vector<std::unique_ptr<DebounceRule>> rules);
+  DebounceRuleIndex(const DebounceRuleIndex&) = delete;
+  DebounceRuleIndex& operator=(const DebounceRuleIndex&) = delete;
+  ~DebounceRuleIndex();
+
+  // Parses the contents of debounce.json. Entries that can't be converted are
+  // skipped. Returns nullptr if |contents| is not valid JSON.
+  static std::unique_ptr<DebounceRuleIndex> CreateFromJSON(
+      const std::string& contents);
+
+  // Applies the rules to |original_url| with the same semantics as walking the
+  // whole list: rules run in order, a rewrite continues with the next rule on
+  // the new URL, and no rule is applied twice. Only URLs whose eTLD+1 is named
+  // by some include pattern are considered at all. Returns true and sets
+  // |final_url| if the URL changed.
+  bool Apply(const GURL& original_url, GURL* final_url) const;
+
+  const std::vector<std::unique_ptr<DebounceRule>>& rules() const {
+    return rules_;
+  }
+
+ private:
+  // Returns the index of the first rule at or after |start| that is either in
+  // |site_rules| or can match any site, or rules_.size() if there is none.
+  size_t NextCandidate(const std::vector<size_t>* site_rules,
+                       size_t start) const;
+
+  std::vector<std::unique_ptr<DebounceRule>> rules_;
+  // Ascending rule indices, by eTLD+1.
+  base::flat_map<std::string, std::vector<size_t>> rules_by_etldp1_;
+  // Ascending indices of rules that can match any site.
+  std::vector<size_t> any_site_rules_;
+};
+
+}  // namespace debounce
+
+#endif  // BRAVE_COMPONENTS_DEBOUNCE_BROWSER_DEBOUNCE_RULE_INDEX_H_
@@ -0,0 +1,92 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/strings/strcat.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/stringprintf.h"
+#include "base/timer/lap_timer.h"
+#include "brave/components/debounce/browser/debounce_rule_index.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_result_reporter.h"
+#include "url/gurl.h"
+
+// Run with --gtest_also_run_disabled_tests.
+
+namespace debounce {
+
+namespace {
+
+constexpr int kSiteCount = 1000;
+
+// Mirrors the shape of the shipped debounce.json: mostly one or two exact and
+// subdomain patterns per tracker site, some with excludes, plus a few rules
+// that match on any host.
+std::string MakeRealisticRules() {
+  std::string json = "[";
+  for (int i = 0; i < kSiteCount; ++i) {
+    const std::string site = base::StrCat({"tracker", base::NumberToString(i),
+                                           i % 3 ? ".com" : ".co.uk"});
+    base::StrAppend(&json, {i ? "," : "", "{\"include\": [\"*://", site,
+                            "/*\", \"*://*.", site, "/redirect?*\"], "});
+    if (i % 5 == 0) {
+      base::StrAppend(&json,
+                      {"\"exclude\": [\"*://login.", site, "/*\"], "});
+    }
+    base::StrAppend(&json, {"\"action\": \"",
+                            i % 4 ? "redirect" : "base64,redirect",
+                            "\", \"param\": \"",
+                            i % 2 ? "url" : "u", "\"}"});
+  }
+  for (const char* path : {"/out", "/click", "/r"}) {
+    base::StrAppend(&json,
+                    {",{\"include\": [\"*://*/", path,
+                     "?*\"], \"action\": \"redirect\", \"param\": \"to\"}"});
+  }
+  json += "]";
+  return json;
+}
+
+std::vector<GURL> MakeNavigations() {
+  std::vector<GURL> urls;
+  for (int i = 0; i < 100; ++i) {
+    // Most navigations are to sites without rules.
+    urls.emplace_back(base::StringPrintf("https://www.site%d.org/page", i));
+    urls.emplace_back(base::StringPrintf(
+        "https://news.site%d.net/article?id=%d&ref=home", i, i));
+    urls.emplace_back(base::StringPrintf(
+        "https://tracker%d.com/?url=https%%3A%%2F%%2Fexample%d.org%%2F",
+        i * 3 + 1, i));
+  }
+  return urls;
+}
+
+}  // namespace
+
+TEST(DebounceRuleIndexPerfTest, DISABLED_Apply) {
+  std::unique_ptr<DebounceRuleIndex> index =
+      DebounceRuleIndex::CreateFromJSON(MakeRealisticRules());
+  ASSERT_TRUE(index);
+  const std::vector<GURL> urls = MakeNavigations();
+
+  perf_test::PerfResultReporter reporter("DebounceRuleIndex", "Apply");
+  reporter.RegisterImportantMetric("_per_url", "ns");
+  base::LapTimer timer;
+  do {
+    for (const GURL& url : urls) {
+      GURL final_url;
+      index->Apply(url, &final_url);
+    }
+    timer.NextLap();
+  } while (!timer.HasTimeLimitExpired());
+  reporter.AddResult(
+      "_per_url",
+      timer.TimePerLap().InNanoseconds() / static_cast<double>(urls.size()));
+}
+
+}  // namespace debounce
@@ -0,0 +1,147 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/debounce/browser/debounce_rule_index.h"
+
+#include <memory>
+#include <string>
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace debounce {
+
+namespace {
+
+const char kRules[] = R"([
+  {
+    "include": [ "http://simple.a.com/?url=*" ],
+    "exclude": [],
+    "action": "redirect",
+    "param": "url"
+  },
+  {
+    "include": [ "http://double.b.com/?url=*" ],
+    "exclude": [],
+    "action": "redirect",
+    "param": "url"
+  },
+  {
+    "include": [ "http://*.c.com/?url=*" ],
+    "exclude": [ "http://excluded.c.com/*" ],
+    "action": "redirect",
+    "param": "url"
+  },
+  {
+    "include": [ "http://first.d.com/?url=*" ],
+    "exclude": [],
+    "action": "redirect",
+    "param": "url"
+  },
+  {
+    "include": [ "http://*/anysite?url=*" ],
+    "exclude": [],
+    "action": "redirect",
+    "param": "url"
+  },
+  {
+    "include": [ "http://*.co.uk/?url=*" ],
+    "exclude": [],
+    "action": "redirect",
+    "param": "url"
+  }
+])";
+
+std::unique_ptr<DebounceRuleIndex> CreateIndex() {
+  std::unique_ptr<DebounceRuleIndex> index =
+      DebounceRuleIndex::CreateFromJSON(kRules);
+  EXPECT_TRUE(index);
+  return index;
+}
+
+}  // namespace
+
+TEST(DebounceRuleIndexTest, InvalidJSON) {
+  EXPECT_FALSE(DebounceRuleIndex::CreateFromJSON("[{"));
+  EXPECT_FALSE(DebounceRuleIndex::CreateFromJSON("{}"));
+}
+
+TEST(DebounceRuleIndexTest, SkipsInvalidRules) {
+  std::unique_ptr<DebounceRuleIndex> index =
+      DebounceRuleIndex::CreateFromJSON(R"([
+    { "include": "not a list", "action": "redirect", "param": "url" },
+    { "include": [ "http://a.com/*" ], "action": "redirect", "param": "url" }
+  ])");
+  ASSERT_TRUE(index);
+  EXPECT_EQ(1u, index->rules().size());
+}
+
+TEST(DebounceRuleIndexTest, Redirect) {
+  std::unique_ptr<DebounceRuleIndex> index = CreateIndex();
+  GURL final_url;
+  EXPECT_TRUE(index->Apply(GURL("http://simple.a.com/?url=https://z.com/"),
+                           &final_url));
+  EXPECT_EQ(GURL("https://z.com/"), final_url);
+}
+
+TEST(DebounceRuleIndexTest, SiteWithoutRules) {
+  std::unique_ptr<DebounceRuleIndex> index = CreateIndex();
+  GURL final_url;
+  // Rules that can match any site don't make every site a candidate.
+  EXPECT_FALSE(index->Apply(GURL("http://z.com/anysite?url=https://y.com/"),
+                            &final_url));
+  EXPECT_FALSE(
+      index->Apply(GURL("http://other.a.com/?url=https://z.com/"), &final_url));
+}
+
+TEST(DebounceRuleIndexTest, SubdomainWildcard) {
+  std::unique_ptr<DebounceRuleIndex> index = CreateIndex();
+  GURL final_url;
+  EXPECT_TRUE(index->Apply(GURL("http://tracker.c.com/?url=https://z.com/"),
+                           &final_url));
+  EXPECT_EQ(GURL("https://z.com/"), final_url);
+  EXPECT_FALSE(index->Apply(
+      GURL("http://excluded.c.com/?url=https://z.com/"), &final_url));
+}
+
+TEST(DebounceRuleIndexTest, LaterRulesApplyToRewrittenURL) {
+  std::unique_ptr<DebounceRuleIndex> index = CreateIndex();
+  GURL final_url;
+  // a.com -> b.com -> c.com -> z.com, each hop handled by a later rule.
+  EXPECT_TRUE(index->Apply(
+      GURL("http://simple.a.com/?url=http%3A%2F%2Fdouble.b.com%2F%3Furl%3D"
+           "http%253A%252F%252Fx.c.com%252F%253Furl%253Dhttps%25253A%25252F"
+           "%25252Fz.com%25252F"),
+      &final_url));
+  EXPECT_EQ(GURL("https://z.com/"), final_url);
+}
+
+TEST(DebounceRuleIndexTest, EarlierRulesAreNotReapplied) {
+  std::unique_ptr<DebounceRuleIndex> index = CreateIndex();
+  GURL final_url;
+  // d.com -> a.com stops there, since the a.com rule comes first.
+  EXPECT_TRUE(index->Apply(
+      GURL("http://first.d.com/?url=http%3A%2F%2Fsimple.a.com%2F%3Furl%3D"
+           "https%253A%252F%252Fz.com%252F"),
+      &final_url));
+  EXPECT_EQ(GURL("http://simple.a.com/?url=https%3A%2F%2Fz.com%2F"),
+            final_url);
+}
+
+TEST(DebounceRuleIndexTest, AnySiteRulesApplyToCandidateSites) {
+  std::unique_ptr<DebounceRuleIndex> index = CreateIndex();
+  GURL final_url;
+  EXPECT_TRUE(index->Apply(
+      GURL("http://simple.a.com/anysite?url=https://z.com/"), &final_url));
+  EXPECT_EQ(GURL("https://z.com/"), final_url);
+  // Hosts on a registry are indexed under the empty eTLD+1.
+  EXPECT_FALSE(index->Apply(GURL("http://tracker.co.uk/?url=https://z.com/"),
+                            &final_url));
+  EXPECT_TRUE(
+      index->Apply(GURL("http://1.2.3.4/anysite?url=https://z.com/"),
+                   &final_url));
+}
+
+}  // namespace debounce
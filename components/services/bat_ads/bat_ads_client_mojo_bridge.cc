@@ -7,9 +7,10 @@
 
 #include <utility>
 
+#include "base/logging.h"
+#include "base/strings/string_number_conversions.h"
 #include "mojo/public/cpp/bindings/interface_request.h"
 #include "mojo/public/cpp/bindings/sync_call_restrictions.h"
-#include "base/logging.h"
 
 namespace bat_ads {
 
@@ -165,22 +166,21 @@ void BatAdsClientMojoBridge::Save(
       std::move(callback)));
 }
 
-void OnLoadAdsResource(const ads::LoadCallback& callback,
-                       const bool success,
-                       const std::string& value) {
-  callback(success, value);
+void OnLoadFileResource(const ads::LoadFileCallback& callback,
+                        base::File file) {
+  callback(std::move(file));
 }
 
-void BatAdsClientMojoBridge::LoadAdsResource(const std::string& id,
-                                             const int version,
-                                             ads::LoadCallback callback) {
+void BatAdsClientMojoBridge::LoadFileResource(const std::string& id,
+                                              const int version,
+                                              ads::LoadFileCallback callback) {
   if (!connected()) {
-    callback(/* success */ false, "");
+    callback(base::File());
     return;
   }
 
-  bat_ads_client_->LoadAdsResource(
-      id, version, base::BindOnce(&OnLoadAdsResource, std::move(callback)));
+  bat_ads_client_->LoadFileResource(
+      id, version, base::BindOnce(&OnLoadFileResource, std::move(callback)));
 }
 
 void OnGetBrowsingHistory(const ads::GetBrowsingHistoryCallback& callback,
@@ -303,6 +303,11 @@ void BatAdsClientMojoBridge::Log(
 
 bool BatAdsClientMojoBridge::GetBooleanPref(
     const std::string& path) const {
+  const base::Value* cached_value = GetCachedPref(path);
+  if (cached_value && cached_value->is_bool()) {
+    return cached_value->GetBool();
+  }
+
   bool value = false;
 
   if (!connected()) {
@@ -310,6 +315,7 @@ bool BatAdsClientMojoBridge::GetBooleanPref(
   }
 
   bat_ads_client_->GetBooleanPref(path, &value);
+  CachePref(path, base::Value(value));
   return value;
 }
 
@@ -320,11 +326,17 @@ void BatAdsClientMojoBridge::SetBooleanPref(
     return;
   }
 
+  CachePref(path, base::Value(value));
   bat_ads_client_->SetBooleanPref(path, value);
 }
 
 int BatAdsClientMojoBridge::GetIntegerPref(
     const std::string& path) const {
+  const base::Value* cached_value = GetCachedPref(path);
+  if (cached_value && cached_value->is_int()) {
+    return cached_value->GetInt();
+  }
+
   int value = 0;
 
   if (!connected()) {
@@ -332,6 +344,7 @@ int BatAdsClientMojoBridge::GetIntegerPref(
   }
 
   bat_ads_client_->GetIntegerPref(path, &value);
+  CachePref(path, base::Value(value));
   return value;
 }
 
@@ -342,11 +355,17 @@ void BatAdsClientMojoBridge::SetIntegerPref(
     return;
   }
 
+  CachePref(path, base::Value(value));
   bat_ads_client_->SetIntegerPref(path, value);
 }
 
 double BatAdsClientMojoBridge::GetDoublePref(
     const std::string& path) const {
+  const base::Value* cached_value = GetCachedPref(path);
+  if (cached_value && cached_value->is_double()) {
+    return cached_value->GetDouble();
+  }
+
   double value = 0.0;
 
   if (!connected()) {
@@ -354,6 +373,7 @@ double BatAdsClientMojoBridge::GetDoublePref(
   }
 
   bat_ads_client_->GetDoublePref(path, &value);
+  CachePref(path, base::Value(value));
   return value;
 }
 
@@ -364,11 +384,17 @@ void BatAdsClientMojoBridge::SetDoublePref(
     return;
   }
 
+  CachePref(path, base::Value(value));
   bat_ads_client_->SetDoublePref(path, value);
 }
 
 std::string BatAdsClientMojoBridge::GetStringPref(
     const std::string& path) const {
+  const base::Value* cached_value = GetCachedPref(path);
+  if (cached_value && cached_value->is_string()) {
+    return cached_value->GetString();
+  }
+
   std::string value;
 
   if (!connected()) {
@@ -376,6 +402,7 @@ std::string BatAdsClientMojoBridge::GetStringPref(
   }
 
   bat_ads_client_->GetStringPref(path, &value);
+  CachePref(path, base::Value(value));
   return value;
 }
 
@@ -386,11 +413,20 @@ void BatAdsClientMojoBridge::SetStringPref(
     return;
   }
 
+  CachePref(path, base::Value(value));
   bat_ads_client_->SetStringPref(path, value);
 }
 
 int64_t BatAdsClientMojoBridge::GetInt64Pref(
     const std::string& path) const {
+  // 64-bit integers are mirrored as strings, matching |PrefService|
+  const base::Value* cached_value = GetCachedPref(path);
+  int64_t cached_int64 = 0;
+  if (cached_value && cached_value->is_string() &&
+      base::StringToInt64(cached_value->GetString(), &cached_int64)) {
+    return cached_int64;
+  }
+
   int64_t value = 0;
 
   if (!connected()) {
@@ -398,6 +434,7 @@ int64_t BatAdsClientMojoBridge::GetInt64Pref(
   }
 
   bat_ads_client_->GetInt64Pref(path, &value);
+  CachePref(path, base::Value(base::NumberToString(value)));
   return value;
 }
 
@@ -408,11 +445,19 @@ void BatAdsClientMojoBridge::SetInt64Pref(
     return;
   }
 
+  CachePref(path, base::Value(base::NumberToString(value)));
   bat_ads_client_->SetInt64Pref(path, value);
 }
 
 uint64_t BatAdsClientMojoBridge::GetUint64Pref(
     const std::string& path) const {
+  const base::Value* cached_value = GetCachedPref(path);
+  uint64_t cached_uint64 = 0;
+  if (cached_value && cached_value->is_string() &&
+      base::StringToUint64(cached_value->GetString(), &cached_uint64)) {
+    return cached_uint64;
+  }
+
   uint64_t value = 0;
 
   if (!connected()) {
@@ -420,6 +465,7 @@ uint64_t BatAdsClientMojoBridge::GetUint64Pref(
   }
 
   bat_ads_client_->GetUint64Pref(path, &value);
+  CachePref(path, base::Value(base::NumberToString(value)));
   return value;
 }
 
@@ -430,6 +476,7 @@ void BatAdsClientMojoBridge::SetUint64Pref(
     return;
   }
 
+  CachePref(path, base::Value(base::NumberToString(value)));
   bat_ads_client_->SetUint64Pref(path, value);
 }
 
@@ -439,13 +486,48 @@ void BatAdsClientMojoBridge::ClearPref(
     return;
   }
 
+  // Clearing a pref reverts it to its default value which is only known by
+  // the browser, so the next read must be fetched
+  pref_cache_.erase(path);
   bat_ads_client_->ClearPref(path);
 }
 
+void BatAdsClientMojoBridge::InvalidatePref(
+    const std::string& path,
+    const base::Value& value) {
+  // Writes made by the ads library are echoed back once the browser has
+  // applied them, so keep the mirrored value if it is the one written. A
+  // different value is either a change made by the browser or an echo of an
+  // earlier write, and in both cases the browser's current value must be
+  // fetched
+  const base::Value* cached_value = GetCachedPref(path);
+  if (cached_value && *cached_value == value) {
+    return;
+  }
+
+  pref_cache_.erase(path);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 bool BatAdsClientMojoBridge::connected() const {
   return bat_ads_client_.is_bound();
 }
 
+const base::Value* BatAdsClientMojoBridge::GetCachedPref(
+    const std::string& path) const {
+  const auto iter = pref_cache_.find(path);
+  if (iter == pref_cache_.end()) {
+    return nullptr;
+  }
+
+  return &iter->second;
+}
+
+void BatAdsClientMojoBridge::CachePref(
+    const std::string& path,
+    base::Value value) const {
+  pref_cache_.insert_or_assign(path, std::move(value));
+}
+
 }  // namespace bat_ads
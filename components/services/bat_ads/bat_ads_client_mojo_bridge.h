@@ -10,6 +10,8 @@
 #include <string>
 #include <vector>
 
+#include "base/containers/flat_map.h"
+#include "base/values.h"
 #include "bat/ads/ad_notification_info.h"
 #include "bat/ads/ads_client.h"
 #include "brave/components/services/bat_ads/public/interfaces/bat_ads.mojom.h"
@@ -57,9 +59,9 @@ class BatAdsClientMojoBridge
       const std::string& name,
       const std::string& value,
       ads::ResultCallback callback) override;
-  void LoadAdsResource(const std::string& id,
-                       const int version,
-                       ads::LoadCallback callback) override;
+  void LoadFileResource(const std::string& id,
+                        const int version,
+                        ads::LoadFileCallback callback) override;
 
   void GetBrowsingHistory(const int max_count,
                           const int days_ago,
@@ -139,10 +141,28 @@ class BatAdsClientMojoBridge
   void ClearPref(
       const std::string& path) override;
 
+  // Must be called whenever the browser changes a pref, including on behalf of
+  // the ads library, with the browser's new |value|. Keeps the locally
+  // mirrored value if it matches, otherwise drops it so that the next read is
+  // fetched from the browser
+  void InvalidatePref(
+      const std::string& path,
+      const base::Value& value);
+
  private:
   bool connected() const;
 
+  const base::Value* GetCachedPref(
+      const std::string& path) const;
+  void CachePref(
+      const std::string& path,
+      base::Value value) const;
+
   mojo::AssociatedRemote<mojom::BatAdsClient> bat_ads_client_;
+
+  // Mirror of prefs read or written by the ads library so that repeated reads
+  // do not require a synchronous round trip to the browser process
+  mutable base::flat_map<std::string, base::Value> pref_cache_;
 };
 
 }  // namespace bat_ads
@@ -0,0 +1,229 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/services/bat_ads/bat_ads_client_mojo_bridge.h"
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "base/bind.h"
+#include "base/containers/flat_map.h"
+#include "base/notreached.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/test/task_environment.h"
+#include "base/threading/thread.h"
+#include "base/values.h"
+#include "brave/components/services/bat_ads/public/interfaces/bat_ads.mojom-test-utils.h"
+#include "mojo/public/cpp/bindings/associated_receiver.h"
+#include "mojo/public/cpp/bindings/associated_remote.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=BatAdsClientMojoBridgeTest*
+
+namespace bat_ads {
+
+namespace {
+
+const char kPath[] = "brave.brave_ads.test";
+
+// Browser side of the bat ads client, holding prefs in memory and counting
+// the sync pref reads made by the bridge
+class TestBatAdsClient : public mojom::BatAdsClientInterceptorForTesting {
+ public:
+  TestBatAdsClient() = default;
+  ~TestBatAdsClient() override = default;
+
+  TestBatAdsClient(const TestBatAdsClient&) = delete;
+  TestBatAdsClient& operator=(const TestBatAdsClient&) = delete;
+
+  void Bind(
+      mojo::PendingAssociatedReceiver<mojom::BatAdsClient> pending_receiver) {
+    receiver_ = std::make_unique<mojo::AssociatedReceiver<mojom::BatAdsClient>>(
+        this, std::move(pending_receiver));
+  }
+
+  void Unbind() { receiver_.reset(); }
+
+  int get_pref_count() const { return get_pref_count_; }
+
+  void set_pref(const std::string& path, base::Value value) {
+    prefs_.insert_or_assign(path, std::move(value));
+  }
+
+  // mojom::BatAdsClientInterceptorForTesting:
+  mojom::BatAdsClient* GetForwardingInterface() override {
+    NOTREACHED();
+    return nullptr;
+  }
+
+  void GetBooleanPref(const std::string& path,
+                      GetBooleanPrefCallback callback) override {
+    get_pref_count_++;
+    const auto iter = prefs_.find(path);
+    std::move(callback).Run(iter != prefs_.end() && iter->second.GetBool());
+  }
+
+  void SetBooleanPref(const std::string& path, const bool value) override {
+    set_pref(path, base::Value(value));
+  }
+
+  void GetInt64Pref(const std::string& path,
+                    GetInt64PrefCallback callback) override {
+    get_pref_count_++;
+    int64_t value = 0;
+    const auto iter = prefs_.find(path);
+    if (iter != prefs_.end()) {
+      base::StringToInt64(iter->second.GetString(), &value);
+    }
+    std::move(callback).Run(value);
+  }
+
+  void SetInt64Pref(const std::string& path, const int64_t value) override {
+    set_pref(path, base::Value(base::NumberToString(value)));
+  }
+
+  void GetUint64Pref(const std::string& path,
+                     GetUint64PrefCallback callback) override {
+    get_pref_count_++;
+    uint64_t value = 0;
+    const auto iter = prefs_.find(path);
+    if (iter != prefs_.end()) {
+      base::StringToUint64(iter->second.GetString(), &value);
+    }
+    std::move(callback).Run(value);
+  }
+
+  void SetUint64Pref(const std::string& path, const uint64_t value) override {
+    set_pref(path, base::Value(base::NumberToString(value)));
+  }
+
+  void ClearPref(const std::string& path) override { prefs_.erase(path); }
+
+ private:
+  std::unique_ptr<mojo::AssociatedReceiver<mojom::BatAdsClient>> receiver_;
+
+  // Prefs as stored by |PrefService|, with 64-bit integers as strings
+  base::flat_map<std::string, base::Value> prefs_;
+
+  std::atomic<int> get_pref_count_{0};
+};
+
+}  // namespace
+
+class BatAdsClientMojoBridgeTest : public testing::Test {
+ protected:
+  BatAdsClientMojoBridgeTest() : client_thread_("BatAdsClient") {}
+
+  ~BatAdsClientMojoBridgeTest() override = default;
+
+  void SetUp() override {
+    // The bridge reads prefs with sync calls, so the browser side must run on
+    // another thread
+    ASSERT_TRUE(client_thread_.Start());
+
+    mojo::AssociatedRemote<mojom::BatAdsClient> remote;
+    client_thread_.task_runner()->PostTask(
+        FROM_HERE,
+        base::BindOnce(&TestBatAdsClient::Bind, base::Unretained(&client_),
+                       remote.BindNewEndpointAndPassDedicatedReceiver()));
+    bridge_ = std::make_unique<BatAdsClientMojoBridge>(remote.Unbind());
+  }
+
+  void TearDown() override {
+    bridge_.reset();
+    client_thread_.task_runner()->PostTask(
+        FROM_HERE, base::BindOnce(&TestBatAdsClient::Unbind,
+                                  base::Unretained(&client_)));
+    client_thread_.Stop();
+  }
+
+  // Changes a pref in the browser without going through the bridge
+  void SetBrowserPref(const std::string& path, base::Value value) {
+    client_thread_.task_runner()->PostTask(
+        FROM_HERE,
+        base::BindOnce(&TestBatAdsClient::set_pref, base::Unretained(&client_),
+                       path, std::move(value)));
+    client_thread_.FlushForTesting();
+  }
+
+  base::test::TaskEnvironment task_environment_;
+  base::Thread client_thread_;
+  TestBatAdsClient client_;
+  std::unique_ptr<BatAdsClientMojoBridge> bridge_;
+};
+
+TEST_F(BatAdsClientMojoBridgeTest, CachedPrefIsReadWithoutIpc) {
+  SetBrowserPref(kPath, base::Value(true));
+
+  EXPECT_TRUE(bridge_->GetBooleanPref(kPath));
+  EXPECT_TRUE(bridge_->GetBooleanPref(kPath));
+
+  EXPECT_EQ(1, client_.get_pref_count());
+}
+
+TEST_F(BatAdsClientMojoBridgeTest, WrittenPrefIsReadWithoutIpc) {
+  bridge_->SetBooleanPref(kPath, true);
+
+  EXPECT_TRUE(bridge_->GetBooleanPref(kPath));
+
+  EXPECT_EQ(0, client_.get_pref_count());
+}
+
+TEST_F(BatAdsClientMojoBridgeTest, InvalidatePrefKeepsMatchingValue) {
+  bridge_->SetBooleanPref(kPath, true);
+
+  // Echo of the write above
+  bridge_->InvalidatePref(kPath, base::Value(true));
+
+  EXPECT_TRUE(bridge_->GetBooleanPref(kPath));
+  EXPECT_EQ(0, client_.get_pref_count());
+}
+
+TEST_F(BatAdsClientMojoBridgeTest, InvalidatePrefDropsChangedValue) {
+  SetBrowserPref(kPath, base::Value(true));
+  EXPECT_TRUE(bridge_->GetBooleanPref(kPath));
+
+  SetBrowserPref(kPath, base::Value(false));
+  bridge_->InvalidatePref(kPath, base::Value(false));
+
+  EXPECT_FALSE(bridge_->GetBooleanPref(kPath));
+  EXPECT_EQ(2, client_.get_pref_count());
+}
+
+TEST_F(BatAdsClientMojoBridgeTest, ClearPrefDropsCachedValue) {
+  bridge_->SetBooleanPref(kPath, true);
+
+  bridge_->ClearPref(kPath);
+
+  EXPECT_FALSE(bridge_->GetBooleanPref(kPath));
+  EXPECT_EQ(1, client_.get_pref_count());
+}
+
+TEST_F(BatAdsClientMojoBridgeTest, Int64PrefRoundTripsAsString) {
+  const int64_t value = std::numeric_limits<int64_t>::min();
+  bridge_->SetInt64Pref(kPath, value);
+
+  // |PrefService| holds 64-bit integers as strings
+  bridge_->InvalidatePref(kPath, base::Value(base::NumberToString(value)));
+
+  EXPECT_EQ(value, bridge_->GetInt64Pref(kPath));
+  EXPECT_EQ(0, client_.get_pref_count());
+}
+
+TEST_F(BatAdsClientMojoBridgeTest, Uint64PrefRoundTripsAsString) {
+  const uint64_t value = std::numeric_limits<uint64_t>::max();
+  SetBrowserPref(kPath, base::Value(base::NumberToString(value)));
+
+  EXPECT_EQ(value, bridge_->GetUint64Pref(kPath));
+  EXPECT_EQ(value, bridge_->GetUint64Pref(kPath));
+
+  EXPECT_EQ(1, client_.get_pref_count());
+}
+
+}  // namespace bat_ads
@@ -62,12 +62,20 @@ void BatAdsImpl::Shutdown(
   ads_->Shutdown(shutdown_callback);
 }
 
+void BatAdsImpl::FlushState(FlushStateCallback callback) {
+  auto* holder = new CallbackHolder<FlushStateCallback>(AsWeakPtr(),
+      std::move(callback));
+
+  ads_->FlushState(std::bind(BatAdsImpl::OnFlushState, holder, _1));
+}
+
 void BatAdsImpl::ChangeLocale(
     const std::string& locale) {
   ads_->ChangeLocale(locale);
 }
 
-void BatAdsImpl::OnPrefChanged(const std::string& path) {
+void BatAdsImpl::OnPrefChanged(const std::string& path, base::Value value) {
+  bat_ads_client_mojo_proxy_->InvalidatePref(path, value);
   ads_->OnPrefChanged(path);
 }
 
@@ -305,6 +313,15 @@ void BatAdsImpl::OnShutdown(CallbackHolder<ShutdownCallback>* holder,
   delete holder;
 }
 
+void BatAdsImpl::OnFlushState(CallbackHolder<FlushStateCallback>* holder,
+                              const bool success) {
+  if (holder->is_valid()) {
+    std::move(holder->get()).Run(success);
+  }
+
+  delete holder;
+}
+
 void BatAdsImpl::OnGetInlineContentAd(
     CallbackHolder<GetInlineContentAdCallback>* holder,
     const bool success,
@@ -13,6 +13,7 @@
 #include <vector>
 
 #include "base/memory/weak_ptr.h"
+#include "base/values.h"
 #include "bat/ads/ads.h"
 #include "bat/ads/public/interfaces/ads.mojom.h"
 #include "bat/ads/statement_info.h"
@@ -44,10 +45,12 @@ class BatAdsImpl :
   void Shutdown(
       ShutdownCallback callback) override;
 
+  void FlushState(FlushStateCallback callback) override;
+
   void ChangeLocale(
       const std::string& locale) override;
 
-  void OnPrefChanged(const std::string& path) override;
+  void OnPrefChanged(const std::string& path, base::Value value) override;
 
   void OnHtmlLoaded(const int32_t tab_id,
                     const std::vector<std::string>& redirect_chain,
@@ -183,6 +186,9 @@ class BatAdsImpl :
     static void OnShutdown(CallbackHolder<ShutdownCallback>* holder,
                            const bool success);
 
+    static void OnFlushState(CallbackHolder<FlushStateCallback>* holder,
+                             const bool success);
+
     static void OnGetInlineContentAd(
         CallbackHolder<GetInlineContentAdCallback>* holder,
         const bool success,
@@ -141,28 +141,27 @@ void AdsClientMojoBridge::Log(
 }
 
 // static
-void AdsClientMojoBridge::OnLoadAdsResource(
-    CallbackHolder<LoadCallback>* holder,
-    const bool success,
-    const std::string& value) {
+void AdsClientMojoBridge::OnLoadFileResource(
+    CallbackHolder<LoadFileResourceCallback>* holder,
+    base::File file) {
   DCHECK(holder);
 
   if (holder->is_valid()) {
-    std::move(holder->get()).Run(success, std::move(value));
+    std::move(holder->get()).Run(std::move(file));
   }
 
   delete holder;
 }
 
-void AdsClientMojoBridge::LoadAdsResource(const std::string& id,
-                                          const int version,
-                                          LoadCallback callback) {
-  // this gets deleted in OnLoad
-  auto* holder =
-      new CallbackHolder<LoadCallback>(AsWeakPtr(), std::move(callback));
-  ads_client_->LoadAdsResource(
+void AdsClientMojoBridge::LoadFileResource(const std::string& id,
+                                           const int version,
+                                           LoadFileResourceCallback callback) {
+  // this gets deleted in OnLoadFileResource
+  auto* holder = new CallbackHolder<LoadFileResourceCallback>(
+      AsWeakPtr(), std::move(callback));
+  ads_client_->LoadFileResource(
       id, version,
-      std::bind(AdsClientMojoBridge::OnLoadAdsResource, holder, _1, _2));
+      std::bind(AdsClientMojoBridge::OnLoadFileResource, holder, _1));
 }
 
 // static
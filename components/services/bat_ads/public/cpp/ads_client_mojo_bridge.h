@@ -67,9 +67,9 @@ class AdsClientMojoBridge
       const int32_t line,
       const int32_t verbose_level,
       const std::string& message) override;
-  void LoadAdsResource(const std::string& id,
-                       const int version,
-                       LoadCallback callback) override;
+  void LoadFileResource(const std::string& id,
+                        const int version,
+                        LoadFileResourceCallback callback) override;
 
   void GetBrowsingHistory(const int max_count,
                           const int days_ago,
@@ -167,9 +167,9 @@ class AdsClientMojoBridge
     Callback callback_;
   };
 
-  static void OnLoadAdsResource(CallbackHolder<LoadCallback>* holder,
-                                const bool success,
-                                const std::string& value);
+  static void OnLoadFileResource(
+      CallbackHolder<LoadFileResourceCallback>* holder,
+      base::File file);
 
   static void OnGetBrowsingHistory(
       CallbackHolder<GetBrowsingHistoryCallback>* holder,
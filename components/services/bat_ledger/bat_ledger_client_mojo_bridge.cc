@@ -11,6 +11,8 @@
 #include <vector>
 
 #include "base/logging.h"
+#include "base/strings/string_number_conversions.h"
+#include "bat/ledger/option_keys.h"
 
 namespace bat_ledger {
 
@@ -149,117 +151,231 @@ void BatLedgerClientMojoBridge::PublisherListNormalized(
 }
 
 void BatLedgerClientMojoBridge::SetBooleanState(const std::string& name,
-                                               bool value) {
+                                                bool value) {
+  CacheState(name, base::Value(value));
+  DropStateDerivedOptions();
   bat_ledger_client_->SetBooleanState(name, value);
 }
 
-bool BatLedgerClientMojoBridge::GetBooleanState(const std::string& name) const {
-  bool value;
+bool BatLedgerClientMojoBridge::GetBooleanState(
+    const std::string& name) const {
+  const base::Value* cached_value = GetCachedState(name);
+  if (cached_value && cached_value->is_bool()) {
+    return cached_value->GetBool();
+  }
+
+  bool value = false;
   bat_ledger_client_->GetBooleanState(name, &value);
+  CacheState(name, base::Value(value));
   return value;
 }
 
 void BatLedgerClientMojoBridge::SetIntegerState(const std::string& name,
-                                               int value) {
+                                                int value) {
+  CacheState(name, base::Value(value));
+  DropStateDerivedOptions();
   bat_ledger_client_->SetIntegerState(name, value);
 }
 
-int BatLedgerClientMojoBridge::GetIntegerState(const std::string& name) const {
-  int value;
+int BatLedgerClientMojoBridge::GetIntegerState(
+    const std::string& name) const {
+  const base::Value* cached_value = GetCachedState(name);
+  if (cached_value && cached_value->is_int()) {
+    return cached_value->GetInt();
+  }
+
+  int value = 0;
   bat_ledger_client_->GetIntegerState(name, &value);
+  CacheState(name, base::Value(value));
   return value;
 }
 
 void BatLedgerClientMojoBridge::SetDoubleState(const std::string& name,
-                                              double value) {
+                                               double value) {
+  CacheState(name, base::Value(value));
+  DropStateDerivedOptions();
   bat_ledger_client_->SetDoubleState(name, value);
 }
 
 double BatLedgerClientMojoBridge::GetDoubleState(
     const std::string& name) const {
-  double value;
+  const base::Value* cached_value = GetCachedState(name);
+  if (cached_value && cached_value->is_double()) {
+    return cached_value->GetDouble();
+  }
+
+  double value = 0.0;
   bat_ledger_client_->GetDoubleState(name, &value);
+  CacheState(name, base::Value(value));
   return value;
 }
 
 void BatLedgerClientMojoBridge::SetStringState(const std::string& name,
-                              const std::string& value) {
+                                               const std::string& value) {
+  CacheState(name, base::Value(value));
+  DropStateDerivedOptions();
   bat_ledger_client_->SetStringState(name, value);
 }
 
-std::string BatLedgerClientMojoBridge::
-GetStringState(const std::string& name) const {
+std::string BatLedgerClientMojoBridge::GetStringState(
+    const std::string& name) const {
+  const base::Value* cached_value = GetCachedState(name);
+  if (cached_value && cached_value->is_string()) {
+    return cached_value->GetString();
+  }
+
   std::string value;
   bat_ledger_client_->GetStringState(name, &value);
+  CacheState(name, base::Value(value));
   return value;
 }
 
 void BatLedgerClientMojoBridge::SetInt64State(const std::string& name,
-                                             int64_t value) {
+                                              int64_t value) {
+  CacheState(name, base::Value(base::NumberToString(value)));
+  DropStateDerivedOptions();
   bat_ledger_client_->SetInt64State(name, value);
 }
 
 int64_t BatLedgerClientMojoBridge::GetInt64State(
     const std::string& name) const {
-  int64_t value;
+  const base::Value* cached_value = GetCachedState(name);
+  int64_t cached_int64 = 0;
+  if (cached_value && cached_value->is_string() &&
+      base::StringToInt64(cached_value->GetString(), &cached_int64)) {
+    return cached_int64;
+  }
+
+  int64_t value = 0;
   bat_ledger_client_->GetInt64State(name, &value);
+  CacheState(name, base::Value(base::NumberToString(value)));
   return value;
 }
 
 void BatLedgerClientMojoBridge::SetUint64State(const std::string& name,
-                                              uint64_t value) {
+                                               uint64_t value) {
+  CacheState(name, base::Value(base::NumberToString(value)));
+  DropStateDerivedOptions();
   bat_ledger_client_->SetUint64State(name, value);
 }
 
 uint64_t BatLedgerClientMojoBridge::GetUint64State(
     const std::string& name) const {
-  uint64_t value;
+  const base::Value* cached_value = GetCachedState(name);
+  uint64_t cached_uint64 = 0;
+  if (cached_value && cached_value->is_string() &&
+      base::StringToUint64(cached_value->GetString(), &cached_uint64)) {
+    return cached_uint64;
+  }
+
+  uint64_t value = 0;
   bat_ledger_client_->GetUint64State(name, &value);
+  CacheState(name, base::Value(base::NumberToString(value)));
   return value;
 }
 
 void BatLedgerClientMojoBridge::ClearState(const std::string& name) {
+  // Clearing a state reverts it to its default value which is only known by
+  // the browser, so the next read must be fetched
+  state_cache_.erase(name);
+  DropStateDerivedOptions();
   bat_ledger_client_->ClearState(name);
 }
 
+void BatLedgerClientMojoBridge::InvalidateState(const std::string& name,
+                                                const base::Value& value) {
+  // Writes made by the ledger are echoed back once the browser has applied
+  // them, so keep the mirrored value if it is the one written. A different
+  // value is either a change made by the browser or an echo of an earlier
+  // write, and in both cases the browser's current value must be fetched
+  const base::Value* cached_value = GetCachedState(name);
+  if (cached_value && *cached_value == value) {
+    return;
+  }
+
+  state_cache_.erase(name);
+  DropStateDerivedOptions();
+}
+
 bool BatLedgerClientMojoBridge::GetBooleanOption(
     const std::string& name) const {
-  bool value;
+  const base::Value* cached_value = GetCachedOption(name);
+  if (cached_value && cached_value->is_bool()) {
+    return cached_value->GetBool();
+  }
+
+  bool value = false;
   bat_ledger_client_->GetBooleanOption(name, &value);
+  CacheOption(name, base::Value(value));
   return value;
 }
 
-int BatLedgerClientMojoBridge::GetIntegerOption(const std::string& name) const {
-  int value;
+int BatLedgerClientMojoBridge::GetIntegerOption(
+    const std::string& name) const {
+  const base::Value* cached_value = GetCachedOption(name);
+  if (cached_value && cached_value->is_int()) {
+    return cached_value->GetInt();
+  }
+
+  int value = 0;
   bat_ledger_client_->GetIntegerOption(name, &value);
+  CacheOption(name, base::Value(value));
   return value;
 }
 
 double BatLedgerClientMojoBridge::GetDoubleOption(
     const std::string& name) const {
-  double value;
+  const base::Value* cached_value = GetCachedOption(name);
+  if (cached_value && cached_value->is_double()) {
+    return cached_value->GetDouble();
+  }
+
+  double value = 0.0;
   bat_ledger_client_->GetDoubleOption(name, &value);
+  CacheOption(name, base::Value(value));
   return value;
 }
 
 std::string BatLedgerClientMojoBridge::GetStringOption(
     const std::string& name) const {
+  const base::Value* cached_value = GetCachedOption(name);
+  if (cached_value && cached_value->is_string()) {
+    return cached_value->GetString();
+  }
+
   std::string value;
   bat_ledger_client_->GetStringOption(name, &value);
+  CacheOption(name, base::Value(value));
   return value;
 }
 
 int64_t BatLedgerClientMojoBridge::GetInt64Option(
     const std::string& name) const {
-  int64_t value;
+  const base::Value* cached_value = GetCachedOption(name);
+  int64_t cached_int64 = 0;
+  if (cached_value && cached_value->is_string() &&
+      base::StringToInt64(cached_value->GetString(), &cached_int64)) {
+    return cached_int64;
+  }
+
+  int64_t value = 0;
   bat_ledger_client_->GetInt64Option(name, &value);
+  CacheOption(name, base::Value(base::NumberToString(value)));
   return value;
 }
 
 uint64_t BatLedgerClientMojoBridge::GetUint64Option(
     const std::string& name) const {
-  uint64_t value;
+  const base::Value* cached_value = GetCachedOption(name);
+  uint64_t cached_uint64 = 0;
+  if (cached_value && cached_value->is_string() &&
+      base::StringToUint64(cached_value->GetString(), &cached_uint64)) {
+    return cached_uint64;
+  }
+
+  uint64_t value = 0;
   bat_ledger_client_->GetUint64Option(name, &value);
+  CacheOption(name, base::Value(base::NumberToString(value)));
   return value;
 }
 
@@ -267,6 +383,42 @@ bool BatLedgerClientMojoBridge::Connected() const {
   return bat_ledger_client_.is_bound();
 }
 
+const base::Value* BatLedgerClientMojoBridge::GetCachedState(
+    const std::string& name) const {
+  const auto iter = state_cache_.find(name);
+  if (iter == state_cache_.end()) {
+    return nullptr;
+  }
+
+  return &iter->second;
+}
+
+void BatLedgerClientMojoBridge::CacheState(const std::string& name,
+                                           base::Value value) const {
+  state_cache_.insert_or_assign(name, std::move(value));
+}
+
+void BatLedgerClientMojoBridge::DropStateDerivedOptions() {
+  // All options are constant apart from |kIsBitflyerRegion|, which is derived
+  // from the external wallet type
+  option_cache_.erase(ledger::option::kIsBitflyerRegion);
+}
+
+const base::Value* BatLedgerClientMojoBridge::GetCachedOption(
+    const std::string& name) const {
+  const auto iter = option_cache_.find(name);
+  if (iter == option_cache_.end()) {
+    return nullptr;
+  }
+
+  return &iter->second;
+}
+
+void BatLedgerClientMojoBridge::CacheOption(const std::string& name,
+                                            base::Value value) const {
+  option_cache_.insert_or_assign(name, std::move(value));
+}
+
 void BatLedgerClientMojoBridge::OnContributeUnverifiedPublishers(
       ledger::type::Result result,
       const std::string& publisher_key,
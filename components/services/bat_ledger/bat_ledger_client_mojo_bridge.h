@@ -11,7 +11,9 @@
 #include <string>
 #include <vector>
 
+#include "base/containers/flat_map.h"
 #include "base/memory/weak_ptr.h"
+#include "base/values.h"
 #include "bat/ledger/ledger_client.h"
 #include "brave/components/services/bat_ledger/public/interfaces/bat_ledger.mojom.h"
 #include "mojo/public/cpp/bindings/associated_remote.h"
@@ -73,6 +75,12 @@ class BatLedgerClientMojoBridge :
   uint64_t GetUint64State(const std::string& name) const override;
   void ClearState(const std::string& name) override;
 
+  // Must be called whenever the browser changes a state pref, including on
+  // behalf of the ledger, with the browser's new |value|. Keeps the locally
+  // mirrored value if it matches, otherwise drops it so that the next read is
+  // fetched from the browser
+  void InvalidateState(const std::string& name, const base::Value& value);
+
   bool GetBooleanOption(const std::string& name) const override;
   int GetIntegerOption(const std::string& name) const override;
   double GetDoubleOption(const std::string& name) const override;
@@ -125,7 +133,20 @@ class BatLedgerClientMojoBridge :
  private:
   bool Connected() const;
 
+  const base::Value* GetCachedState(const std::string& name) const;
+  void CacheState(const std::string& name, base::Value value) const;
+  void DropStateDerivedOptions();
+
+  const base::Value* GetCachedOption(const std::string& name) const;
+  void CacheOption(const std::string& name, base::Value value) const;
+
   mojo::AssociatedRemote<mojom::BatLedgerClient> bat_ledger_client_;
+
+  // Mirrors of state and options read or written by the ledger so that
+  // repeated reads do not require a synchronous round trip to the browser
+  // process. 64-bit integers are mirrored as strings, matching |PrefService|
+  mutable base::flat_map<std::string, base::Value> state_cache_;
+  mutable base::flat_map<std::string, base::Value> option_cache_;
 };
 
 }  // namespace bat_ledger
@@ -0,0 +1,262 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/services/bat_ledger/bat_ledger_client_mojo_bridge.h"
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "base/bind.h"
+#include "base/containers/flat_map.h"
+#include "base/notreached.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/test/task_environment.h"
+#include "base/threading/thread.h"
+#include "base/values.h"
+#include "bat/ledger/option_keys.h"
+#include "brave/components/services/bat_ledger/public/interfaces/bat_ledger.mojom-test-utils.h"
+#include "mojo/public/cpp/bindings/associated_receiver.h"
+#include "mojo/public/cpp/bindings/associated_remote.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=BatLedgerClientMojoBridgeTest*
+
+namespace bat_ledger {
+
+namespace {
+
+const char kName[] = "test";
+const char kConstantOption[] = "constant";
+
+// Browser side of the bat ledger client, holding state and options in memory
+// and counting the sync reads made by the bridge
+class TestBatLedgerClient : public mojom::BatLedgerClientInterceptorForTesting {
+ public:
+  TestBatLedgerClient() = default;
+  ~TestBatLedgerClient() override = default;
+
+  TestBatLedgerClient(const TestBatLedgerClient&) = delete;
+  TestBatLedgerClient& operator=(const TestBatLedgerClient&) = delete;
+
+  void Bind(mojo::PendingAssociatedReceiver<mojom::BatLedgerClient>
+                pending_receiver) {
+    receiver_ =
+        std::make_unique<mojo::AssociatedReceiver<mojom::BatLedgerClient>>(
+            this, std::move(pending_receiver));
+  }
+
+  void Unbind() { receiver_.reset(); }
+
+  int get_state_count() const { return get_state_count_; }
+  int get_option_count() const { return get_option_count_; }
+
+  void set_state(const std::string& name, base::Value value) {
+    state_.insert_or_assign(name, std::move(value));
+  }
+
+  // mojom::BatLedgerClientInterceptorForTesting:
+  mojom::BatLedgerClient* GetForwardingInterface() override {
+    NOTREACHED();
+    return nullptr;
+  }
+
+  void GetBooleanState(const std::string& name,
+                       GetBooleanStateCallback callback) override {
+    get_state_count_++;
+    const auto iter = state_.find(name);
+    std::move(callback).Run(iter != state_.end() && iter->second.GetBool());
+  }
+
+  void SetBooleanState(const std::string& name, const bool value) override {
+    set_state(name, base::Value(value));
+  }
+
+  void GetInt64State(const std::string& name,
+                     GetInt64StateCallback callback) override {
+    get_state_count_++;
+    int64_t value = 0;
+    const auto iter = state_.find(name);
+    if (iter != state_.end()) {
+      base::StringToInt64(iter->second.GetString(), &value);
+    }
+    std::move(callback).Run(value);
+  }
+
+  void SetInt64State(const std::string& name, const int64_t value) override {
+    set_state(name, base::Value(base::NumberToString(value)));
+  }
+
+  void GetUint64State(const std::string& name,
+                      GetUint64StateCallback callback) override {
+    get_state_count_++;
+    uint64_t value = 0;
+    const auto iter = state_.find(name);
+    if (iter != state_.end()) {
+      base::StringToUint64(iter->second.GetString(), &value);
+    }
+    std::move(callback).Run(value);
+  }
+
+  void SetUint64State(const std::string& name, const uint64_t value) override {
+    set_state(name, base::Value(base::NumberToString(value)));
+  }
+
+  void ClearState(const std::string& name) override { state_.erase(name); }
+
+  void GetBooleanOption(const std::string& name,
+                        GetBooleanOptionCallback callback) override {
+    get_option_count_++;
+    std::move(callback).Run(true);
+  }
+
+ private:
+  std::unique_ptr<mojo::AssociatedReceiver<mojom::BatLedgerClient>> receiver_;
+
+  // State as stored by |PrefService|, with 64-bit integers as strings
+  base::flat_map<std::string, base::Value> state_;
+
+  std::atomic<int> get_state_count_{0};
+  std::atomic<int> get_option_count_{0};
+};
+
+}  // namespace
+
+class BatLedgerClientMojoBridgeTest : public testing::Test {
+ protected:
+  BatLedgerClientMojoBridgeTest() : client_thread_("BatLedgerClient") {}
+
+  ~BatLedgerClientMojoBridgeTest() override = default;
+
+  void SetUp() override {
+    // The bridge reads state and options with sync calls, so the browser side
+    // must run on another thread
+    ASSERT_TRUE(client_thread_.Start());
+
+    mojo::AssociatedRemote<mojom::BatLedgerClient> remote;
+    client_thread_.task_runner()->PostTask(
+        FROM_HERE,
+        base::BindOnce(&TestBatLedgerClient::Bind, base::Unretained(&client_),
+                       remote.BindNewEndpointAndPassDedicatedReceiver()));
+    bridge_ = std::make_unique<BatLedgerClientMojoBridge>(remote.Unbind());
+  }
+
+  void TearDown() override {
+    bridge_.reset();
+    client_thread_.task_runner()->PostTask(
+        FROM_HERE, base::BindOnce(&TestBatLedgerClient::Unbind,
+                                  base::Unretained(&client_)));
+    client_thread_.Stop();
+  }
+
+  // Changes state in the browser without going through the bridge
+  void SetBrowserState(const std::string& name, base::Value value) {
+    client_thread_.task_runner()->PostTask(
+        FROM_HERE, base::BindOnce(&TestBatLedgerClient::set_state,
+                                  base::Unretained(&client_), name,
+                                  std::move(value)));
+    client_thread_.FlushForTesting();
+  }
+
+  base::test::TaskEnvironment task_environment_;
+  base::Thread client_thread_;
+  TestBatLedgerClient client_;
+  std::unique_ptr<BatLedgerClientMojoBridge> bridge_;
+};
+
+TEST_F(BatLedgerClientMojoBridgeTest, CachedStateIsReadWithoutIpc) {
+  SetBrowserState(kName, base::Value(true));
+
+  EXPECT_TRUE(bridge_->GetBooleanState(kName));
+  EXPECT_TRUE(bridge_->GetBooleanState(kName));
+
+  EXPECT_EQ(1, client_.get_state_count());
+}
+
+TEST_F(BatLedgerClientMojoBridgeTest, WrittenStateIsReadWithoutIpc) {
+  bridge_->SetBooleanState(kName, true);
+
+  EXPECT_TRUE(bridge_->GetBooleanState(kName));
+
+  EXPECT_EQ(0, client_.get_state_count());
+}
+
+TEST_F(BatLedgerClientMojoBridgeTest, InvalidateStateKeepsMatchingValue) {
+  EXPECT_TRUE(bridge_->GetBooleanOption(kConstantOption));
+
+  bridge_->SetBooleanState(kName, true);
+
+  // Echo of the write above
+  bridge_->InvalidateState(kName, base::Value(true));
+
+  EXPECT_TRUE(bridge_->GetBooleanState(kName));
+  EXPECT_TRUE(bridge_->GetBooleanOption(kConstantOption));
+  EXPECT_EQ(0, client_.get_state_count());
+  EXPECT_EQ(1, client_.get_option_count());
+}
+
+TEST_F(BatLedgerClientMojoBridgeTest, InvalidateStateDropsChangedValue) {
+  SetBrowserState(kName, base::Value(true));
+  EXPECT_TRUE(bridge_->GetBooleanState(kName));
+
+  SetBrowserState(kName, base::Value(false));
+  bridge_->InvalidateState(kName, base::Value(false));
+
+  EXPECT_FALSE(bridge_->GetBooleanState(kName));
+  EXPECT_EQ(2, client_.get_state_count());
+}
+
+TEST_F(BatLedgerClientMojoBridgeTest, ClearStateDropsCachedValue) {
+  bridge_->SetBooleanState(kName, true);
+
+  bridge_->ClearState(kName);
+
+  EXPECT_FALSE(bridge_->GetBooleanState(kName));
+  EXPECT_EQ(1, client_.get_state_count());
+}
+
+TEST_F(BatLedgerClientMojoBridgeTest, Int64StateRoundTripsAsString) {
+  const int64_t value = std::numeric_limits<int64_t>::min();
+  bridge_->SetInt64State(kName, value);
+
+  // |PrefService| holds 64-bit integers as strings
+  bridge_->InvalidateState(kName, base::Value(base::NumberToString(value)));
+
+  EXPECT_EQ(value, bridge_->GetInt64State(kName));
+  EXPECT_EQ(0, client_.get_state_count());
+}
+
+TEST_F(BatLedgerClientMojoBridgeTest, Uint64StateRoundTripsAsString) {
+  const uint64_t value = std::numeric_limits<uint64_t>::max();
+  SetBrowserState(kName, base::Value(base::NumberToString(value)));
+
+  EXPECT_EQ(value, bridge_->GetUint64State(kName));
+  EXPECT_EQ(value, bridge_->GetUint64State(kName));
+
+  EXPECT_EQ(1, client_.get_state_count());
+}
+
+TEST_F(BatLedgerClientMojoBridgeTest, CachedOptionIsReadWithoutIpc) {
+  EXPECT_TRUE(bridge_->GetBooleanOption(kConstantOption));
+  EXPECT_TRUE(bridge_->GetBooleanOption(kConstantOption));
+
+  EXPECT_EQ(1, client_.get_option_count());
+}
+
+TEST_F(BatLedgerClientMojoBridgeTest, StateChangeDropsOnlyDerivedOptions) {
+  EXPECT_TRUE(bridge_->GetBooleanOption(kConstantOption));
+  EXPECT_TRUE(bridge_->GetBooleanOption(ledger::option::kIsBitflyerRegion));
+
+  bridge_->InvalidateState(kName, base::Value(true));
+
+  EXPECT_TRUE(bridge_->GetBooleanOption(kConstantOption));
+  EXPECT_TRUE(bridge_->GetBooleanOption(ledger::option::kIsBitflyerRegion));
+  EXPECT_EQ(3, client_.get_option_count());
+}
+
+}  // namespace bat_ledger
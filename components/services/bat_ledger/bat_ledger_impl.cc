@@ -1154,4 +1154,9 @@ void BatLedgerImpl::GetWalletPassphrase(GetWalletPassphraseCallback callback) {
   std::move(callback).Run(ledger_->GetWalletPassphrase());
 }
 
+void BatLedgerImpl::OnStateChanged(const std::string& name,
+                                   base::Value value) {
+  bat_ledger_client_mojo_bridge_->InvalidateState(name, value);
+}
+
 }  // namespace bat_ledger
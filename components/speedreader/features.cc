@@ -19,4 +19,9 @@ const base::Feature kSpeedreaderFeature {
 #endif
 };
 
+// Feeds the response body to the rewriter while it is being downloaded instead
+// of after the whole body has been buffered.
+const base::Feature kSpeedreaderStreamingFeature{
+    "SpeedreaderStreaming", base::FEATURE_ENABLED_BY_DEFAULT};
+
 }  // namespace speedreader
@@ -12,6 +12,7 @@ struct Feature;
 
 namespace speedreader {
 extern const base::Feature kSpeedreaderFeature;
+extern const base::Feature kSpeedreaderStreamingFeature;
 }  // namespace speedreader
 
 #endif  // BRAVE_COMPONENTS_SPEEDREADER_FEATURES_H_
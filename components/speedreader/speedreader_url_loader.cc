@@ -10,9 +10,12 @@
 #include <utility>
 
 #include "base/bind.h"
+#include "base/feature_list.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/task/post_task.h"
 #include "base/task/thread_pool.h"
+#include "base/timer/elapsed_timer.h"
+#include "brave/components/speedreader/features.h"
 #include "brave/components/speedreader/rust/ffi/speedreader.h"
 #include "brave/components/speedreader/speedreader_result_delegate.h"
 #include "brave/components/speedreader/speedreader_rewriter_service.h"
@@ -27,8 +30,53 @@ namespace {
 
 constexpr uint32_t kReadBufferSize = 32768;
 
+// The original body is kept around while streaming, so it can be sent as is
+// if distilling fails. Bodies larger than this are never distilled.
+constexpr size_t kMaxStreamingBodySize = 8 * 1024 * 1024;
+
+// TODO(brave-browser/issues/10372): would be better to pass explicit signal
+// back from rewriter to indicate if content was found
+constexpr size_t kMinDistilledSize = 1024;
+
 }  // namespace
 
+class SpeedReaderURLLoader::Distiller {
+ public:
+  explicit Distiller(std::unique_ptr<Rewriter> rewriter)
+      : rewriter_(std::move(rewriter)) {}
+  Distiller(const Distiller&) = delete;
+  Distiller& operator=(const Distiller&) = delete;
+  ~Distiller() = default;
+
+  void Write(std::string chunk) {
+    if (failed_)
+      return;
+    base::ElapsedTimer timer;
+    failed_ = rewriter_->Write(chunk.data(), chunk.length()) != 0;
+    distill_time_ += timer.Elapsed();
+  }
+
+  // Returns the distilled page, or nullopt if the original body should be
+  // sent.
+  absl::optional<std::string> Finish(const std::string& stylesheet) {
+    if (failed_)
+      return absl::nullopt;
+    base::ElapsedTimer timer;
+    rewriter_->End();
+    const std::string& transformed = rewriter_->GetOutput();
+    distill_time_ += timer.Elapsed();
+    UMA_HISTOGRAM_TIMES("Brave.Speedreader.Distill", distill_time_);
+    if (transformed.length() < kMinDistilledSize)
+      return absl::nullopt;
+    return stylesheet + transformed;
+  }
+
+ private:
+  std::unique_ptr<Rewriter> rewriter_;
+  bool failed_ = false;
+  base::TimeDelta distill_time_;
+};
+
 // static
 std::tuple<mojo::PendingRemote<network::mojom::URLLoader>,
            mojo::PendingReceiver<network::mojom::URLLoaderClient>,
@@ -74,6 +122,7 @@ SpeedReaderURLLoader::SpeedReaderURLLoader(
       body_producer_watcher_(FROM_HERE,
                              mojo::SimpleWatcher::ArmingPolicy::MANUAL,
                              std::move(task_runner)),
+      distiller_(nullptr, base::OnTaskRunnerDeleter(nullptr)),
       rewriter_service_(rewriter_service) {}
 
 SpeedReaderURLLoader::~SpeedReaderURLLoader() = default;
@@ -133,9 +182,21 @@ void SpeedReaderURLLoader::OnStartLoadingResponseBody(
       MOJO_HANDLE_SIGNAL_READABLE | MOJO_HANDLE_SIGNAL_PEER_CLOSED,
       base::BindRepeating(&SpeedReaderURLLoader::OnBodyReadable,
                           base::Unretained(this)));
+  if (base::FeatureList::IsEnabled(kSpeedreaderStreamingFeature) &&
+      rewriter_service_) {
+    StartStreamingDistiller();
+  }
   body_consumer_watcher_.ArmOrNotify();
 }
 
+void SpeedReaderURLLoader::StartStreamingDistiller() {
+  distill_task_runner_ = base::ThreadPool::CreateSequencedTaskRunner(
+      {base::TaskPriority::USER_BLOCKING});
+  distiller_ = std::unique_ptr<Distiller, base::OnTaskRunnerDeleter>(
+      new Distiller(rewriter_service_->MakeRewriter(response_url_)),
+      base::OnTaskRunnerDeleter(distill_task_runner_));
+}
+
 void SpeedReaderURLLoader::OnComplete(
     const network::URLLoaderCompletionStatus& status) {
   DCHECK(!complete_status_.has_value());
@@ -197,7 +258,13 @@ void SpeedReaderURLLoader::ResumeReadingBodyFromNet() {
 }
 
 void SpeedReaderURLLoader::OnBodyReadable(MojoResult) {
-  DCHECK_EQ(State::kLoading, state_);
+  DCHECK(state_ == State::kLoading || (state_ == State::kSending &&
+                                       pass_through_));
+  if (state_ == State::kSending) {
+    // Everything read so far has been sent.
+    DCHECK_EQ(0u, bytes_remaining_in_buffer_);
+    buffered_body_.clear();
+  }
 
   size_t start_size = buffered_body_.size();
   uint32_t read_bytes = kReadBufferSize;
@@ -210,9 +277,14 @@ void SpeedReaderURLLoader::OnBodyReadable(MojoResult) {
     case MOJO_RESULT_FAILED_PRECONDITION:
       // Reading is finished.
       buffered_body_.resize(start_size);
+      if (state_ == State::kSending) {
+        CompleteSending();
+        return;
+      }
       MaybeLaunchSpeedreader();
       return;
     case MOJO_RESULT_SHOULD_WAIT:
+      buffered_body_.resize(start_size);
       body_consumer_watcher_.ArmOrNotify();
       return;
     default:
@@ -222,10 +294,23 @@ void SpeedReaderURLLoader::OnBodyReadable(MojoResult) {
 
   DCHECK_EQ(MOJO_RESULT_OK, result);
   buffered_body_.resize(start_size + read_bytes);
-  // TODO(iefremov): We actually can partially |pumpContent| to speedreader,
-  // but skipping it for now to simplify things. Pumping is not free in terms
-  // of CPU ticks, so we will have to keep alive speedreader instance on another
-  // thread.
+
+  if (state_ == State::kSending) {
+    bytes_remaining_in_buffer_ = buffered_body_.size();
+    SendReceivedBodyToClient();
+    return;
+  }
+
+  if (distiller_) {
+    if (buffered_body_.size() > kMaxStreamingBodySize) {
+      StartPassThrough();
+      return;
+    }
+    distill_task_runner_->PostTask(
+        FROM_HERE,
+        base::BindOnce(&Distiller::Write, base::Unretained(distiller_.get()),
+                       buffered_body_.substr(start_size)));
+  }
 
   body_consumer_watcher_.ArmOrNotify();
 }
@@ -234,6 +319,8 @@ void SpeedReaderURLLoader::OnBodyWritable(MojoResult r) {
   DCHECK_EQ(State::kSending, state_);
   if (bytes_remaining_in_buffer_ > 0) {
     SendReceivedBodyToClient();
+  } else if (pass_through_ && body_consumer_handle_.is_valid()) {
+    body_consumer_watcher_.ArmOrNotify();
   } else {
     CompleteSending();
   }
@@ -249,6 +336,24 @@ void SpeedReaderURLLoader::MaybeLaunchSpeedreader() {
   VLOG(2) << __func__ << " buffered body size = " << buffered_body_.size();
   bytes_remaining_in_buffer_ = buffered_body_.size();
 
+  if (distiller_) {
+    if (bytes_remaining_in_buffer_ == 0) {
+      distiller_.reset();
+      CompleteLoading(std::move(buffered_body_));
+      return;
+    }
+    // The body has already been written to the rewriter, only the end of the
+    // document is left to process. |buffered_body_| is kept in case the page
+    // can't be distilled.
+    distill_task_runner_->PostTaskAndReplyWithResult(
+        FROM_HERE,
+        base::BindOnce(&Distiller::Finish, base::Unretained(distiller_.get()),
+                       rewriter_service_->GetContentStylesheet()),
+        base::BindOnce(&SpeedReaderURLLoader::OnStreamingDistillComplete,
+                       weak_factory_.GetWeakPtr()));
+    return;
+  }
+
   if (bytes_remaining_in_buffer_ > 0) {
     // Offload heavy distilling to another thread.
     base::ThreadPool::PostTaskAndReplyWithResult(
@@ -266,10 +371,7 @@ void SpeedReaderURLLoader::MaybeLaunchSpeedreader() {
               rewriter->End();
               const std::string& transformed = rewriter->GetOutput();
 
-              // TODO(brave-browser/issues/10372): would be better to pass
-              // explicit signal back from rewriter to indicate if content was
-              // found
-              if (transformed.length() < 1024) {
+              if (transformed.length() < kMinDistilledSize) {
                 return data;
               }
 
@@ -285,6 +387,23 @@ void SpeedReaderURLLoader::MaybeLaunchSpeedreader() {
   CompleteLoading(std::move(buffered_body_));
 }
 
+void SpeedReaderURLLoader::OnStreamingDistillComplete(
+    absl::optional<std::string> distilled) {
+  distiller_.reset();
+  if (distilled) {
+    CompleteLoading(std::move(*distilled));
+    return;
+  }
+  CompleteLoading(std::move(buffered_body_));
+}
+
+void SpeedReaderURLLoader::StartPassThrough() {
+  VLOG(2) << __func__ << " body is too large to distill: " << response_url_;
+  distiller_.reset();
+  pass_through_ = true;
+  CompleteLoading(std::move(buffered_body_));
+}
+
 void SpeedReaderURLLoader::CompleteLoading(std::string body) {
   DCHECK_EQ(State::kLoading, state_);
   state_ = State::kSending;
@@ -378,6 +497,7 @@ void SpeedReaderURLLoader::Abort() {
   state_ = State::kAborted;
   body_consumer_watcher_.Cancel();
   body_producer_watcher_.Cancel();
+  distiller_.reset();
   source_url_loader_.reset();
   source_url_client_receiver_.reset();
   destination_url_loader_client_.reset();
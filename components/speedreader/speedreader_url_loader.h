@@ -6,6 +6,7 @@
 #ifndef BRAVE_COMPONENTS_SPEEDREADER_SPEEDREADER_URL_LOADER_H_
 #define BRAVE_COMPONENTS_SPEEDREADER_SPEEDREADER_URL_LOADER_H_
 
+#include <memory>
 #include <string>
 #include <tuple>
 #include <vector>
@@ -13,6 +14,7 @@
 #include "base/callback.h"
 #include "base/memory/ref_counted.h"
 #include "base/memory/weak_ptr.h"
+#include "base/task/sequenced_task_runner.h"
 #include "base/strings/string_piece.h"
 #include "brave/components/speedreader/speedreader_result_delegate.h"
 #include "mojo/public/cpp/bindings/pending_receiver.h"
@@ -42,12 +44,19 @@ class SpeedreaderRewriterService;
 //               kCompleted.
 // kLoading: Receives the body from the source loader and distills the page.
 //            The received body is kept in this loader until distilling
-//            is finished. When all body has been received and distilling is
+//            is finished. With kSpeedreaderStreamingFeature each chunk is
+//            also fed to the rewriter on a worker sequence as it arrives, so
+//            only the end of the document is left to process once the body
+//            is complete. When all body has been received and distilling is
 //            done, this loader will dispatch queued messages like
 //            OnStartLoadingResponseBody() to the destination
 //            loader client, and then the state is changed to kSending.
+//            If a streamed body grows past a fixed limit, distilling is
+//            abandoned and the body is passed through untouched instead.
 // kSending: Receives the body and sends it to the destination loader client.
-//           The state changes to kCompleted after all data is sent.
+//           When passing through, the rest of the source body is forwarded
+//           as it is read. The state changes to kCompleted after all data is
+//           sent.
 // kCompleted: All data has been sent to the destination loader.
 // kAborted: Unexpected behavior happens. Watchers, pipes and the binding from
 //           the source loader to |this| are stopped. All incoming messages from
@@ -115,9 +124,17 @@ class SpeedReaderURLLoader : public network::mojom::URLLoaderClient,
   void PauseReadingBodyFromNet() override;
   void ResumeReadingBodyFromNet() override;
 
+  // Feeds the body to the rewriter as it is read. Lives on
+  // |distill_task_runner_|.
+  class Distiller;
+
   void OnBodyReadable(MojoResult);
   void OnBodyWritable(MojoResult);
   void MaybeLaunchSpeedreader();
+  void StartStreamingDistiller();
+  void OnStreamingDistillComplete(absl::optional<std::string> distilled);
+  // Gives up on distilling and forwards the body untouched.
+  void StartPassThrough();
 
   // Gets either distilled or untouched body.
   void CompleteLoading(std::string body);
@@ -153,6 +170,11 @@ class SpeedReaderURLLoader : public network::mojom::URLLoaderClient,
   mojo::SimpleWatcher body_consumer_watcher_;
   mojo::SimpleWatcher body_producer_watcher_;
 
+  scoped_refptr<base::SequencedTaskRunner> distill_task_runner_;
+  std::unique_ptr<Distiller, base::OnTaskRunnerDeleter> distiller_;
+  // Set when the body is forwarded as it is read, rather than after loading.
+  bool pass_through_ = false;
+
   // Not Owned
   SpeedreaderRewriterService* rewriter_service_;
 
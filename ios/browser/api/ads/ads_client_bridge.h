@@ -20,9 +20,9 @@
 - (bool)canShowBackgroundNotifications;
 - (bool)isNetworkConnectionAvailable;
 - (bool)shouldShowNotifications;
-- (void)loadAdsResource:(const std::string&)id
-                version:(const int)version
-               callback:(ads::LoadCallback)callback;
+- (void)loadFileResource:(const std::string&)id
+                 version:(const int)version
+                callback:(ads::LoadFileCallback)callback;
 - (void)clearScheduledCaptcha;
 - (void)getScheduledCaptcha:(const std::string&)payment_id
                    callback:(ads::GetScheduledCaptchaCallback)callback;
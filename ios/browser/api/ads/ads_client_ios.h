@@ -41,9 +41,9 @@ class AdsClientIOS : public ads::AdsClient {
             const std::string& value,
             ads::ResultCallback callback) override;
   void Load(const std::string& name, ads::LoadCallback callback) override;
-  void LoadAdsResource(const std::string& id,
-                       const int version,
-                       ads::LoadCallback callback) override;
+  void LoadFileResource(const std::string& id,
+                        const int version,
+                        ads::LoadFileCallback callback) override;
   void GetBrowsingHistory(const int max_count,
                           const int days_ago,
                           ads::GetBrowsingHistoryCallback callback) override;
@@ -7,10 +7,13 @@
 #import <UIKit/UIKit.h>
 
 #include <limits>
+#include <utility>
 #import "ad_notification_ios.h"
 #import "ads_client_bridge.h"
 #import "ads_client_ios.h"
 #include "base/base64.h"
+#include "base/files/file.h"
+#include "base/files/file_path.h"
 #include "base/logging.h"
 #include "base/sequenced_task_runner.h"
 #include "base/strings/sys_string_conversions.h"
@@ -1127,23 +1130,24 @@ BATClassAdsBridge(BOOL, isDebug, setDebug, g_is_debug)
   callback({});
 }
 
-- (void)loadAdsResource:(const std::string&)id
-                version:(const int)version
-               callback:(ads::LoadCallback)callback {
+- (void)loadFileResource:(const std::string&)id
+                 version:(const int)version
+                callback:(ads::LoadFileCallback)callback {
   NSString* bridgedId = base::SysUTF8ToNSString(id);
 
   BLOG(1, @"Loading %@ ads resource", bridgedId);
 
-  const std::string contents =
-      [self.commonOps loadContentsFromFileWithName:bridgedId.UTF8String];
-  if (!contents.empty()) {
-    BLOG(1, @"%@ ads resource is cached", bridgedId);
-    callback(/* success */ true, contents);
+  const auto path = [self.commonOps dataPathForFilename:bridgedId];
+  base::File file(base::FilePath(base::SysNSStringToUTF8(path)),
+                  base::File::FLAG_OPEN | base::File::FLAG_READ);
+  if (!file.IsValid()) {
+    BLOG(1, @"%@ ads resource not found", bridgedId);
+    callback(base::File());
     return;
   }
 
-  BLOG(1, @"%@ ads resource not found", bridgedId);
-  callback(/* success */ false, "");
+  BLOG(1, @"%@ ads resource is cached", bridgedId);
+  callback(std::move(file));
 }
 
 - (void)clearScheduledCaptcha {
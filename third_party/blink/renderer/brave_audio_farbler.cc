@@ -0,0 +1,86 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/third_party/blink/renderer/brave_audio_farbler.h"
+
+#include "build/build_config.h"
+
+#if defined(ARCH_CPU_X86_FAMILY)
+#include <emmintrin.h>
+#elif defined(ARCH_CPU_ARM64)
+#include <arm_neon.h>
+#endif
+
+namespace brave {
+
+namespace {
+
+// Multiplies in double precision and rounds once, like the scalar
+// |value * fudge_factor|, so the vector and scalar paths agree bit for bit.
+void MultiplyByConstant(float* data, size_t length, double fudge_factor) {
+  size_t i = 0;
+#if defined(ARCH_CPU_X86_FAMILY)
+  const __m128d factor = _mm_set1_pd(fudge_factor);
+  for (; i + 4 <= length; i += 4) {
+    const __m128 in = _mm_loadu_ps(data + i);
+    const __m128d low = _mm_mul_pd(_mm_cvtps_pd(in), factor);
+    const __m128d high =
+        _mm_mul_pd(_mm_cvtps_pd(_mm_movehl_ps(in, in)), factor);
+    _mm_storeu_ps(data + i,
+                  _mm_movelh_ps(_mm_cvtpd_ps(low), _mm_cvtpd_ps(high)));
+  }
+#elif defined(ARCH_CPU_ARM64)
+  const float64x2_t factor = vdupq_n_f64(fudge_factor);
+  for (; i + 4 <= length; i += 4) {
+    const float32x4_t in = vld1q_f32(data + i);
+    const float64x2_t low = vmulq_f64(vcvt_f64_f32(vget_low_f32(in)), factor);
+    const float64x2_t high = vmulq_f64(vcvt_high_f64_f32(in), factor);
+    vst1q_f32(data + i, vcvt_high_f32_f64(vcvt_f32_f64(low), high));
+  }
+#endif
+  for (; i < length; ++i)
+    data[i] = data[i] * fudge_factor;
+}
+
+}  // namespace
+
+AudioFarbler::AudioFarbler() = default;
+AudioFarbler::~AudioFarbler() = default;
+
+// static
+AudioFarbler AudioFarbler::Balanced(double fudge_factor) {
+  AudioFarbler farbler;
+  farbler.mode_ = Mode::kBalanced;
+  farbler.fudge_factor_ = fudge_factor;
+  return farbler;
+}
+
+// static
+AudioFarbler AudioFarbler::Maximum(uint64_t seed) {
+  AudioFarbler farbler;
+  farbler.mode_ = Mode::kMaximum;
+  farbler.seed_ = seed;
+  return farbler;
+}
+
+void AudioFarbler::FarbleBuffer(float* data, size_t length) const {
+  switch (mode_) {
+    case Mode::kOff:
+      return;
+    case Mode::kBalanced:
+      MultiplyByConstant(data, length, fudge_factor_);
+      return;
+    case Mode::kMaximum: {
+      // The generator is strictly sequential; keeping its state local lets it
+      // live in a register and leaves this instance untouched.
+      uint64_t state = seed_;
+      for (size_t i = 0; i < length; ++i)
+        data[i] = NextPseudoRandom(&state);
+      return;
+    }
+  }
+}
+
+}  // namespace brave
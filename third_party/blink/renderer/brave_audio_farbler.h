@@ -0,0 +1,75 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_THIRD_PARTY_BLINK_RENDERER_BRAVE_AUDIO_FARBLER_H_
+#define BRAVE_THIRD_PARTY_BLINK_RENDERER_BRAVE_AUDIO_FARBLER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "brave/third_party/blink/renderer/brave_lfsr.h"
+
+namespace brave {
+
+// Farbles Web Audio sample data.
+//
+// BALANCED scales every sample by a constant per-domain fudge factor.
+// MAXIMUM replaces the samples with a pseudo-random sequence seeded from the
+// domain key, which restarts at index 0 of every buffer.
+//
+// FarbleBuffer() handles a whole buffer at once and keeps no state, so a
+// farbler may be copied freely. FarbleSample() is for loops that farble an
+// intermediate value per sample; it advances the MAXIMUM generator stored in
+// this instance, so each owner needs its own copy.
+class AudioFarbler {
+ public:
+  enum class Mode { kOff, kBalanced, kMaximum };
+
+  AudioFarbler();
+  ~AudioFarbler();
+
+  static AudioFarbler Balanced(double fudge_factor);
+  static AudioFarbler Maximum(uint64_t seed);
+
+  Mode mode() const { return mode_; }
+  explicit operator bool() const { return mode_ != Mode::kOff; }
+
+  // Farbles |length| samples of |data| in place, |data[0]| being index 0.
+  void FarbleBuffer(float* data, size_t length) const;
+
+  // Returns the farbled |value| of the sample at |index|. For MAXIMUM, calls
+  // must start at index 0 and visit each index in order.
+  float FarbleSample(float value, size_t index) {
+    switch (mode_) {
+      case Mode::kOff:
+        return value;
+      case Mode::kBalanced:
+        return value * fudge_factor_;
+      case Mode::kMaximum:
+        if (index == 0)
+          state_ = seed_;
+        return NextPseudoRandom(&state_);
+    }
+    return value;
+  }
+
+  // Advances the LFSR in |state| and returns a pseudo-random float between 0
+  // and 0.1.
+  static float NextPseudoRandom(uint64_t* state) {
+    *state = lfsr_next(*state);
+    const double max_uint64_as_double = UINT64_MAX;
+    return (*state / max_uint64_as_double) / 10;
+  }
+
+ private:
+  Mode mode_ = Mode::kOff;
+  double fudge_factor_ = 1.0;
+  uint64_t seed_ = 0;
+  uint64_t state_ = 0;
+};
+
+}  // namespace brave
+
+#endif  // BRAVE_THIRD_PARTY_BLINK_RENDERER_BRAVE_AUDIO_FARBLER_H_
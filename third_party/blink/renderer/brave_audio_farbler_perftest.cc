@@ -0,0 +1,104 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/callback.h"
+#include "base/timer/lap_timer.h"
+#include "brave/third_party/blink/renderer/brave_audio_farbler.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_result_reporter.h"
+
+// Run with --gtest_also_run_disabled_tests.
+
+namespace brave {
+
+namespace {
+
+// Five seconds of a 48 kHz channel, as returned by getChannelData().
+constexpr size_t kChannelLength = 5 * 48000;
+// A full size AnalyserNode frame, as read by getFloatTimeDomainData().
+constexpr size_t kAnalyserLength = 2048;
+
+constexpr double kFudgeFactor = 0.995;
+constexpr uint64_t kSeed = 0x0123456789abcdef;
+
+using AudioFarblingCallback = base::RepeatingCallback<float(float, size_t)>;
+
+// The per-sample callbacks BraveSessionCache used to hand out, kept here as
+// the baseline.
+float ConstantMultiplier(double fudge_factor, float value, size_t index) {
+  return value * fudge_factor;
+}
+
+float PseudoRandomSequence(uint64_t seed, float value, size_t index) {
+  static uint64_t v;
+  if (index == 0)
+    v = seed;
+  return AudioFarbler::NextPseudoRandom(&v);
+}
+
+void RunCallback(const std::string& story,
+                 AudioFarblingCallback callback,
+                 size_t length) {
+  std::vector<float> samples(length, 0.5f);
+  perf_test::PerfResultReporter reporter("AudioFarbler", story);
+  reporter.RegisterImportantMetric("_callback", "us");
+  base::LapTimer timer;
+  do {
+    // Refill so repeated BALANCED scaling never drifts into denormals.
+    std::fill(samples.begin(), samples.end(), 0.5f);
+    for (size_t i = 0; i < length; ++i)
+      samples[i] = callback.Run(samples[i], i);
+    timer.NextLap();
+  } while (!timer.HasTimeLimitExpired());
+  reporter.AddResult("_callback", timer.TimePerLap().InMicrosecondsF());
+}
+
+void RunFarbleBuffer(const std::string& story,
+                     const AudioFarbler& farbler,
+                     size_t length) {
+  std::vector<float> samples(length, 0.5f);
+  perf_test::PerfResultReporter reporter("AudioFarbler", story);
+  reporter.RegisterImportantMetric("_buffer", "us");
+  base::LapTimer timer;
+  do {
+    std::fill(samples.begin(), samples.end(), 0.5f);
+    farbler.FarbleBuffer(samples.data(), samples.size());
+    timer.NextLap();
+  } while (!timer.HasTimeLimitExpired());
+  reporter.AddResult("_buffer", timer.TimePerLap().InMicrosecondsF());
+}
+
+}  // namespace
+
+TEST(AudioFarblerPerfTest, DISABLED_BalancedChannel) {
+  RunCallback("BalancedChannel",
+              base::BindRepeating(&ConstantMultiplier, kFudgeFactor),
+              kChannelLength);
+  RunFarbleBuffer("BalancedChannel", AudioFarbler::Balanced(kFudgeFactor),
+                  kChannelLength);
+}
+
+TEST(AudioFarblerPerfTest, DISABLED_MaximumChannel) {
+  RunCallback("MaximumChannel",
+              base::BindRepeating(&PseudoRandomSequence, kSeed),
+              kChannelLength);
+  RunFarbleBuffer("MaximumChannel", AudioFarbler::Maximum(kSeed),
+                  kChannelLength);
+}
+
+TEST(AudioFarblerPerfTest, DISABLED_BalancedAnalyserFrame) {
+  RunCallback("BalancedAnalyserFrame",
+              base::BindRepeating(&ConstantMultiplier, kFudgeFactor),
+              kAnalyserLength);
+  RunFarbleBuffer("BalancedAnalyserFrame",
+                  AudioFarbler::Balanced(kFudgeFactor), kAnalyserLength);
+}
+
+}  // namespace brave
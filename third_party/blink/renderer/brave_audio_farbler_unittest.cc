@@ -0,0 +1,77 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/third_party/blink/renderer/brave_audio_farbler.h"
+
+#include <vector>
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace brave {
+
+namespace {
+
+// Odd length so the scalar tail of the vector loop is covered too.
+constexpr size_t kLength = 1027;
+
+std::vector<float> MakeSamples() {
+  std::vector<float> samples(kLength);
+  for (size_t i = 0; i < kLength; ++i)
+    samples[i] = (static_cast<float>(i % 200) - 100.0f) / 97.0f;
+  return samples;
+}
+
+}  // namespace
+
+TEST(AudioFarblerTest, OffLeavesSamplesUntouched) {
+  AudioFarbler farbler;
+  EXPECT_FALSE(farbler);
+  std::vector<float> samples = MakeSamples();
+  farbler.FarbleBuffer(samples.data(), samples.size());
+  EXPECT_EQ(MakeSamples(), samples);
+  EXPECT_EQ(0.25f, farbler.FarbleSample(0.25f, 0));
+}
+
+TEST(AudioFarblerTest, BalancedBufferMatchesPerSample) {
+  const double fudge_factor = 0.99 + 0.0087654321;
+  AudioFarbler farbler = AudioFarbler::Balanced(fudge_factor);
+  EXPECT_TRUE(farbler);
+  const std::vector<float> original = MakeSamples();
+  std::vector<float> samples = original;
+  farbler.FarbleBuffer(samples.data(), samples.size());
+  for (size_t i = 0; i < kLength; ++i) {
+    const float expected = original[i] * fudge_factor;
+    EXPECT_EQ(expected, samples[i]) << i;
+    EXPECT_EQ(expected, farbler.FarbleSample(original[i], i)) << i;
+  }
+}
+
+TEST(AudioFarblerTest, MaximumBufferMatchesPerSample) {
+  AudioFarbler farbler = AudioFarbler::Maximum(0x0123456789abcdef);
+  std::vector<float> samples = MakeSamples();
+  farbler.FarbleBuffer(samples.data(), samples.size());
+  for (size_t i = 0; i < kLength; ++i) {
+    EXPECT_LE(0.0f, samples[i]);
+    EXPECT_GE(0.1f, samples[i]);
+    EXPECT_EQ(samples[i], farbler.FarbleSample(1.0f, i)) << i;
+  }
+}
+
+TEST(AudioFarblerTest, MaximumRestartsEachBuffer) {
+  AudioFarbler farbler = AudioFarbler::Maximum(42);
+  std::vector<float> first = MakeSamples();
+  farbler.FarbleBuffer(first.data(), first.size());
+  std::vector<float> second(kLength);
+  farbler.FarbleBuffer(second.data(), second.size());
+  EXPECT_EQ(first, second);
+
+  // Restarting the per-sample generator midway yields the same prefix.
+  for (size_t i = 0; i < 10; ++i)
+    farbler.FarbleSample(0.0f, i);
+  for (size_t i = 0; i < kLength; ++i)
+    EXPECT_EQ(first[i], farbler.FarbleSample(0.0f, i)) << i;
+}
+
+}  // namespace brave
@@ -0,0 +1,23 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_THIRD_PARTY_BLINK_RENDERER_BRAVE_CANVAS_HASH_H_
+#define BRAVE_THIRD_PARTY_BLINK_RENDERER_BRAVE_CANVAS_HASH_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace brave {
+
+// Returns a 64-bit digest of |size| bytes of canvas pixels, seeded with
+// |key|. This is the XXH64 construction: four independent accumulator lanes
+// over 32-byte stripes, so it runs close to memory bandwidth on a 4K canvas.
+// It is not a MAC; callers derive the perturbation seed by HMAC-ing the
+// digest, which keeps the crypto pass independent of the canvas size.
+uint64_t CanvasContentHash(const uint8_t* data, size_t size, uint64_t key);
+
+}  // namespace brave
+
+#endif  // BRAVE_THIRD_PARTY_BLINK_RENDERER_BRAVE_CANVAS_HASH_H_
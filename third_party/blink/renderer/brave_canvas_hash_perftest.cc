@@ -0,0 +1,79 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <string>
+#include <vector>
+
+#include "base/debug/alias.h"
+#include "base/strings/string_piece.h"
+#include "base/timer/lap_timer.h"
+#include "brave/third_party/blink/renderer/brave_canvas_hash.h"
+#include "crypto/hmac.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_result_reporter.h"
+
+// Run with --gtest_also_run_disabled_tests.
+
+namespace brave {
+
+namespace {
+
+constexpr uint64_t kKey = 0x0123456789abcdef;
+
+std::vector<uint8_t> MakeCanvas(int width, int height) {
+  std::vector<uint8_t> pixels(static_cast<size_t>(width) * height * 4);
+  for (size_t i = 0; i < pixels.size(); ++i)
+    pixels[i] = static_cast<uint8_t>(i * 31 + (i >> 12));
+  return pixels;
+}
+
+// The full-buffer HMAC-SHA256 PerturbPixelsInternal used to run on every
+// readback.
+void RunHmac(const std::string& story, const std::vector<uint8_t>& pixels) {
+  perf_test::PerfResultReporter reporter("CanvasContentHash", story);
+  reporter.RegisterImportantMetric("_hmac_sha256", "ms");
+  base::LapTimer timer;
+  do {
+    crypto::HMAC h(crypto::HMAC::SHA256);
+    CHECK(h.Init(reinterpret_cast<const unsigned char*>(&kKey), sizeof kKey));
+    uint8_t canvas_key[32];
+    CHECK(h.Sign(base::StringPiece(reinterpret_cast<const char*>(
+                                       pixels.data()),
+                                   pixels.size()),
+                 canvas_key, sizeof canvas_key));
+    timer.NextLap();
+  } while (!timer.HasTimeLimitExpired());
+  reporter.AddResult("_hmac_sha256", timer.TimePerLap().InMillisecondsF());
+}
+
+void RunContentHash(const std::string& story,
+                    const std::vector<uint8_t>& pixels) {
+  perf_test::PerfResultReporter reporter("CanvasContentHash", story);
+  reporter.RegisterImportantMetric("_content_hash", "ms");
+  base::LapTimer timer;
+  uint64_t sink = 0;
+  do {
+    sink += CanvasContentHash(pixels.data(), pixels.size(), kKey);
+    timer.NextLap();
+  } while (!timer.HasTimeLimitExpired());
+  reporter.AddResult("_content_hash", timer.TimePerLap().InMillisecondsF());
+  base::debug::Alias(&sink);
+}
+
+}  // namespace
+
+TEST(CanvasContentHashPerfTest, DISABLED_Canvas4K) {
+  const std::vector<uint8_t> pixels = MakeCanvas(3840, 2160);
+  RunHmac("Canvas4K", pixels);
+  RunContentHash("Canvas4K", pixels);
+}
+
+TEST(CanvasContentHashPerfTest, DISABLED_Canvas1080p) {
+  const std::vector<uint8_t> pixels = MakeCanvas(1920, 1080);
+  RunHmac("Canvas1080p", pixels);
+  RunContentHash("Canvas1080p", pixels);
+}
+
+}  // namespace brave
@@ -0,0 +1,55 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/third_party/blink/renderer/brave_canvas_hash.h"
+
+#include <string.h>
+
+#include <set>
+#include <vector>
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace brave {
+
+namespace {
+
+uint64_t HashString(const char* value, uint64_t key) {
+  return CanvasContentHash(reinterpret_cast<const uint8_t*>(value),
+                           strlen(value), key);
+}
+
+}  // namespace
+
+// Reference values of XXH64, which the perturbation seeds depend on.
+TEST(CanvasContentHashTest, MatchesReferenceValues) {
+  EXPECT_EQ(0xEF46DB3751D8E999ULL, HashString("", 0));
+  EXPECT_EQ(0xD24EC4F1A98C6E5BULL, HashString("a", 0));
+  EXPECT_EQ(0x44BC2CF5AD770999ULL, HashString("abc", 0));
+}
+
+TEST(CanvasContentHashTest, DependsOnKey) {
+  std::vector<uint8_t> pixels(16 * 16 * 4);
+  EXPECT_NE(CanvasContentHash(pixels.data(), pixels.size(), 1),
+            CanvasContentHash(pixels.data(), pixels.size(), 2));
+  EXPECT_EQ(CanvasContentHash(pixels.data(), pixels.size(), 1),
+            CanvasContentHash(pixels.data(), pixels.size(), 1));
+}
+
+TEST(CanvasContentHashTest, EveryByteCounts) {
+  // Cover the stripe loop and each of the tail paths.
+  std::vector<uint8_t> pixels(103, 0x80);
+  std::set<uint64_t> hashes;
+  for (size_t size = 0; size <= pixels.size(); ++size)
+    hashes.insert(CanvasContentHash(pixels.data(), size, 42));
+  for (size_t i = 0; i < pixels.size(); ++i) {
+    pixels[i] ^= 1;
+    hashes.insert(CanvasContentHash(pixels.data(), pixels.size(), 42));
+    pixels[i] ^= 1;
+  }
+  EXPECT_EQ(2 * pixels.size() + 1, hashes.size());
+}
+
+}  // namespace brave
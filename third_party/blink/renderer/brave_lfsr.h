@@ -0,0 +1,21 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_THIRD_PARTY_BLINK_RENDERER_BRAVE_LFSR_H_
+#define BRAVE_THIRD_PARTY_BLINK_RENDERER_BRAVE_LFSR_H_
+
+#include <stdint.h>
+
+namespace brave {
+
+// Returns the state following |v| in the 64-bit LFSR shared by the farbling
+// code.
+inline uint64_t lfsr_next(uint64_t v) {
+  return (v >> 1) | (((v << 62) ^ (v << 61)) & (~(~uint64_t{0} << 63) << 62));
+}
+
+}  // namespace brave
+
+#endif  // BRAVE_THIRD_PARTY_BLINK_RENDERER_BRAVE_LFSR_H_